@@ -10,6 +10,64 @@
 
 /* Forward Declarations */
 static gboolean process_ai_move(gpointer user_data);
+static void play_ai_move(GameState* game_state, const Cell* move);
+
+/* Pending AI timeout or idle callback, 0 if none */
+static guint ai_source = 0;
+/* Idle callback pondering the AI replies, 0 if none */
+static guint ponder_source = 0;
+
+/**
+ * @brief Stop any pending or running AI move, and forget pondered replies.
+ */
+static void cancel_ai() {
+  if (ai_source) g_source_remove(ai_source);
+  ai_source = 0;
+  cancel_ai_move();
+  if (ponder_source) g_source_remove(ponder_source);
+  ponder_source = 0;
+  cancel_ponder();
+}
+
+/**
+ * @brief Schedule the AI move after a short delay, or play it at once if it
+ * was pondered.
+ * @param game_state Pointer to the GameState.
+ */
+static void schedule_ai_move(GameState* game_state) {
+  Cell reply;
+  bool pondered = take_pondered_move(&reply);
+  cancel_ai();
+  if (pondered) {
+    play_ai_move(game_state, &reply);
+    return;
+  }
+  ai_source = g_timeout_add(AI_MOVE_DELAY_MS, process_ai_move, game_state);
+}
+
+/**
+ * @brief Work out the AI replies for a slice of time while the human thinks.
+ * @param user_data Pointer to GameState (unused).
+ * @return G_SOURCE_CONTINUE until every reply is ready.
+ */
+static gboolean ponder_ai_moves(gpointer user_data G_GNUC_UNUSED) {
+  if (!step_ponder(AI_SLICE_MS)) return G_SOURCE_CONTINUE;
+  ponder_source = 0;
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Start pondering if it is the human's turn against the AI.
+ * @param game_state Pointer to the GameState.
+ */
+static void schedule_ponder(GameState* game_state) {
+  if (ponder_source || game_state->mode != MODE_1_PLAYER ||
+      game_state->board.current_player != PLAYER_X) {
+    return;
+  }
+  if (start_ponder() != 0) return;
+  ponder_source = g_idle_add(ponder_ai_moves, game_state);
+}
 
 /**
  * @brief Update a score label with a numeric value.
@@ -144,7 +202,7 @@ static int toggle_top_right(GameState* game_state) {
     gtk_drop_down_set_selected(diff_dropdown,
                                game_state->difficulty - DIFF_EASY);
   } else {
-    // Update undo button to be enabled/disabled based on last move availability
+    // Update undo button to be enabled/disabled based on the move history
     GtkButton* undo_button =
         GTK_BUTTON(gtk_builder_get_object(game_state->builder, "undo_button"));
     if (!undo_button) return -1;
@@ -183,10 +241,10 @@ static int show_win_dialog(GameState* game_state, const char* message) {
  * @param winning_cells Array of the winning cells.
  */
 static void highlight_winning_cells(GameState* game_state,
-                                    const Cell winning_cells[SIZE]) {
+                                    const Cell winning_cells[WIN_LENGTH]) {
   if (!game_state || !game_state->builder || !winning_cells) return;
 
-  for (int i = 0; i < SIZE; i++) {
+  for (int i = 0; i < WIN_LENGTH; i++) {
     int cell_index = winning_cells[i].row * SIZE + winning_cells[i].col + 1;
     char button_name[BUTTON_NAME_SIZE];
     snprintf(button_name, sizeof(button_name), "cell_%d", cell_index);
@@ -206,7 +264,7 @@ static void highlight_winning_cells(GameState* game_state,
 static void clear_winning_highlights(GameState* game_state) {
   if (!game_state || !game_state->builder) return;
 
-  for (int i = 1; i <= 9; i++) {
+  for (int i = 1; i <= SIZE * SIZE; i++) {
     char button_name[BUTTON_NAME_SIZE];
     snprintf(button_name, sizeof(button_name), "cell_%d", i);
 
@@ -228,6 +286,7 @@ static int reset_game_state() {
 
   // Clear winning highlights from previous game
   clear_winning_highlights(game_state);
+  cancel_ai();
 
   // Alternate starting player for next game
   game_state->starting_player =
@@ -236,11 +295,12 @@ static int reset_game_state() {
   init_board(&game_state->board, game_state->starting_player);
   update_board_display(game_state);
 
-  // Schedule AI move if it should go first
+  // Schedule AI move if it should go first, or think during the human's turn
   if (game_state->mode == MODE_1_PLAYER &&
       game_state->board.current_player == PLAYER_O) {
-    g_timeout_add(AI_MOVE_DELAY_MS, process_ai_move, game_state);
+    schedule_ai_move(game_state);
   }
+  schedule_ponder(game_state);
 
   return 0;
 }
@@ -253,7 +313,7 @@ static int reset_game_state() {
 static bool check_game_over(GameState* game_state) {
   if (!game_state || !game_state->builder) return false;
 
-  Cell winning_cells[SIZE];
+  Cell winning_cells[WIN_LENGTH];
   Winner winner = check_winner(&game_state->board, winning_cells);
   if (winner == ONGOING) return false;
 
@@ -292,19 +352,50 @@ static bool check_game_over(GameState* game_state) {
 }
 
 /**
- * @brief Process AI move if it's AI's turn, scheduled via timeout.
+ * @brief Let the AI think for a slice of time, and play its move once ready.
+ *
+ * Runs as an idle callback, so redraws, animations and audio are handled
+ * between slices.
+ *
  * @param user_data Pointer to GameState.
- * @return G_SOURCE_REMOVE to indicate the timeout should not repeat.
+ * @return G_SOURCE_CONTINUE while the AI is thinking, G_SOURCE_REMOVE once it
+ * has moved.
  */
-static gboolean process_ai_move(gpointer user_data) {
+static gboolean think_ai_move(gpointer user_data) {
   GameState* game_state = (GameState*)user_data;
   if (!game_state) return G_SOURCE_REMOVE;
 
-  Cell ai_move = get_ai_move();
-  make_move(&game_state->board, &ai_move);
+  Cell ai_move;
+  if (!step_ai_move(AI_SLICE_MS, &ai_move)) return G_SOURCE_CONTINUE;
+  ai_source = 0;
+  play_ai_move(game_state, &ai_move);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Play the AI move, then ponder the replies to the human's next move.
+ * @param game_state Pointer to the GameState.
+ * @param move Pointer to the AI move.
+ */
+static void play_ai_move(GameState* game_state, const Cell* move) {
+  make_move(&game_state->board, move);
   update_board_display(game_state);
-  check_game_over(game_state);
+  if (!check_game_over(game_state)) schedule_ponder(game_state);
+}
 
+/**
+ * @brief Process AI move if it's AI's turn, scheduled via timeout.
+ * @param user_data Pointer to GameState.
+ * @return G_SOURCE_REMOVE to indicate the timeout should not repeat.
+ */
+static gboolean process_ai_move(gpointer user_data) {
+  GameState* game_state = (GameState*)user_data;
+  ai_source = 0;
+  if (!game_state || start_ai_move() != 0) return G_SOURCE_REMOVE;
+
+  // Think in slices from the main loop rather than blocking it
+  ai_source = g_idle_add(think_ai_move, game_state);
   return G_SOURCE_REMOVE;
 }
 
@@ -315,6 +406,8 @@ static gboolean process_ai_move(gpointer user_data) {
 static void to_main_menu(GtkStack* stack) {
   reset_scoreboard();
   reset_game_state();
+  // No game is shown until the player is picked again
+  cancel_ai();
   gtk_stack_set_visible_child_name(stack, "main_menu");
 }
 
@@ -340,6 +433,9 @@ static void change_difficulty(GtkDropDown* dropdown,
     case 2:
       difficulty = DIFF_HARD;
       break;
+    case 3:
+      difficulty = DIFF_EXPERT;
+      break;
     default:
       difficulty = DIFF_NONE;
       break;
@@ -386,6 +482,8 @@ static void go_back_clicked(GtkBuilder* builder) {
  */
 static void undo_move_handler(gpointer* user_data G_GNUC_UNUSED) {
   GameState* game_state = get_game_state();
+  // Replies pondered for the current board no longer apply
+  cancel_ai();
   if (undo_move(&game_state->board)) update_game();
 }
 
@@ -423,11 +521,12 @@ int update_game() {
   update_board_display(game_state);
   update_scoreboard(game_state);
 
-  // Schedule AI move if it's the AI's turn
+  // Schedule AI move if it's the AI's turn, or ponder during the human's
   if (game_state->mode == MODE_1_PLAYER &&
       game_state->board.current_player == PLAYER_O &&
       check_winner(&game_state->board, NULL) == ONGOING)
-    g_timeout_add(AI_MOVE_DELAY_MS, process_ai_move, game_state);
+    schedule_ai_move(game_state);
+  schedule_ponder(game_state);
 
   return 0;
 }
@@ -450,8 +549,8 @@ void game_board(GtkBuilder* builder, GtkStack* stack) {
                    G_CALLBACK(change_difficulty), NULL);
   g_signal_connect_swapped(undo_button, "clicked",
                            G_CALLBACK(undo_move_handler), NULL);
-  // Connect all 9 cell buttons
-  for (int i = 1; i <= 9; i++) {
+  // Connect all cell buttons
+  for (int i = 1; i <= SIZE * SIZE; i++) {
     char button_name[BUTTON_NAME_SIZE];
     snprintf(button_name, sizeof(button_name), "cell_%d", i);
     GtkButton* cell_button =
@@ -4,6 +4,7 @@
 #include "game.h"
 
 #define AI_MOVE_DELAY_MS 500  // Buffer time for AI move processing
+#define AI_SLICE_MS 4         // Time the AI thinks for per main loop iteration
 #define SCORE_BUFFER_SIZE 6   // Buffer size for score text formatting
 #define BUTTON_NAME_SIZE 20   // Buffer size for button name formatting
 
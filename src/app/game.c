@@ -8,6 +8,9 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <time.h>
+
+#include "../shared/timer.h"
 
 /* Global game state */
 static GameState game_state;
@@ -24,7 +27,14 @@ int init_game_state(GtkBuilder* builder, NaiveBayesModel* model) {
       .stats = {0},
       .builder = builder,
       .nb_model = model,
+      .ai_thinking = false,
+      .ponder = {.active = false},
   };
+  uint64_t seed = (uint64_t)time(NULL);
+  rng_seed(&game_state.rng, seed, 0);
+  rng_seed(&game_state.ponder_rng, seed, 1);
+  if (mcts_arena_init(&game_state.arena, EXPERT_PLAYOUTS + 1) != 0) return -1;
+  nb_quantize_model(model, &game_state.nb_quantized);
   init_board(&game_state.board, PLAYER_X);
   game_state_initialised = true;
 
@@ -54,20 +64,202 @@ int set_difficulty(DifficultyLevel difficulty) {
   return 0;
 }
 
-Cell get_ai_move() {
-  if (!game_state_initialised) return (Cell){-1, -1};
+/**
+ * @brief Get the search options of the expert AI.
+ * @param rng Pointer to the random generator of the playouts.
+ * @return MctsOptions The options.
+ */
+static MctsOptions expert_options(Rng* rng) {
+  return (MctsOptions){
+      .rng = rng,
+      .arena = &game_state.arena,
+      .playouts = EXPERT_PLAYOUTS,
+      .time_limit_ms = EXPERT_TIME_LIMIT_MS,
+  };
+}
 
+/**
+ * @brief Sample the hard AI move from the scores of a finished search, so
+ * close moves get mixed up.
+ * @param task Pointer to the MinimaxTask started by
+ * minimax_task_start_scoring().
+ * @param board Pointer to the Board structure that was searched.
+ * @param rng Pointer to the random generator to sample with.
+ * @return The cell chosen by the AI, random if the search scored no move.
+ */
+static Cell hard_move(const MinimaxTask* task, const Board* board, Rng* rng) {
+  double scores[SIZE * SIZE];
+  if (minimax_task_scores(task, scores) <= 0) return random_move(board, rng);
+  return softmax_scored_move(scores, HARD_TEMPERATURE, rng);
+}
+
+/**
+ * @brief Choose the AI move in a position based on difficulty level.
+ * @param board Pointer to the Board structure, the AI is to move.
+ * @return The cell chosen by the AI.
+ */
+static Cell choose_move(const Board* board) {
   // Random move for first turn or easy difficulty
-  if (game_state.board.move_count == 0 || game_state.difficulty == DIFF_EASY) {
-    return random_move(&game_state.board);
+  if (board->move_count == 0 || game_state.difficulty == DIFF_EASY) {
+    return random_move(board, &game_state.rng);
   }
 
-  // Naive Bayes for medium difficulty
+  // Naive Bayes for medium difficulty, scored with integers only
   if (game_state.difficulty == DIFF_MEDIUM)
-    return nb_find_move(&game_state.board, game_state.nb_model);
+    return nb_quantized_find_move(board, &game_state.nb_quantized);
+
+  // Monte Carlo Tree Search for expert difficulty
+  if (game_state.difficulty == DIFF_EXPERT) {
+    MctsOptions options = expert_options(&game_state.rng);
+    return mcts_find_move(board, &options);
+  }
+
+  // Minimax scores for hard difficulty, searched within the budget in one go
+  MinimaxTask* task = &game_state.hard_search;
+  minimax_task_start_scoring(task, board, false, HARD_NODE_BUDGET);
+  minimax_task_step(task, 0, 0);
+  return hard_move(task, board, &game_state.rng);
+}
+
+Cell get_ai_move() {
+  if (!game_state_initialised) return (Cell){-1, -1};
+  return choose_move(&game_state.board);
+}
+
+int start_ai_move() {
+  if (!game_state_initialised) return -1;
+  game_state.ai_thinking = false;
+
+  // The hard and expert AIs search for long, the others answer at once
+  if (game_state.board.move_count == 0) return 0;
+  if (game_state.difficulty == DIFF_EXPERT) {
+    MctsOptions options = expert_options(&game_state.rng);
+    game_state.ai_thinking =
+        mcts_start(&game_state.search, &game_state.board, &options) == 0;
+  } else if (game_state.difficulty == DIFF_HARD) {
+    minimax_task_start_scoring(&game_state.hard_search, &game_state.board,
+                               false, HARD_NODE_BUDGET);
+    game_state.ai_thinking = true;
+  }
+  return 0;
+}
+
+bool step_ai_move(double max_ms, Cell* move) {
+  if (!game_state_initialised || !move) return true;
+
+  if (!game_state.ai_thinking) {
+    *move = get_ai_move();
+    return true;
+  }
+  if (game_state.difficulty == DIFF_HARD) {
+    MinimaxTask* task = &game_state.hard_search;
+    if (!minimax_task_step(task, 0, max_ms)) return false;
+    game_state.ai_thinking = false;
+    *move = hard_move(task, &game_state.board, &game_state.rng);
+    return true;
+  }
+  if (!mcts_step(&game_state.search, 0, max_ms)) return false;
+  game_state.ai_thinking = false;
+  *move = mcts_result(&game_state.search);
+  return true;
+}
+
+void cancel_ai_move() {
+  if (!game_state_initialised) return;
+  game_state.ai_thinking = false;
+}
+
+int start_ponder() {
+  if (!game_state_initialised) return -1;
+  PonderCache* ponder = &game_state.ponder;
+  ponder->active = false;
+  if (check_winner(&game_state.board, NULL) != ONGOING) return -1;
+  // Only searches that run a slice at a time can ponder within the slice
+  if (game_state.difficulty != DIFF_HARD &&
+      game_state.difficulty != DIFF_EXPERT) {
+    return -1;
+  }
+
+  ponder->num_moves =
+      find_empty_cells(&game_state.board, ponder->moves, SIZE * SIZE);
+  ponder->next_move = 0;
+  ponder->searching = false;
+  ponder->num_replies = 0;
+  ponder->active = true;
+  return 0;
+}
+
+bool step_ponder(double max_ms) {
+  if (!game_state_initialised) return true;
+  PonderCache* ponder = &game_state.ponder;
+  double slice_end_ms = timer_now_ms() + max_ms;
+
+  while (ponder->active && ponder->next_move < ponder->num_moves) {
+    Board board;
+    copy_board(&game_state.board, &board);
+    make_move(&board, &ponder->moves[ponder->next_move]);
+
+    Cell reply = {-1, -1};
+    bool expert = game_state.difficulty == DIFF_EXPERT;
+    if (check_winner(&board, NULL) != ONGOING) {
+      // The game ends on this move, there is nothing to reply
+    } else {
+      // Search a slice at a time like step_ai_move(), reusing its searches
+      if (!ponder->searching) {
+        if (expert) {
+          MctsOptions options = expert_options(&game_state.ponder_rng);
+          ponder->searching =
+              mcts_start(&game_state.search, &board, &options) == 0;
+        } else {
+          minimax_task_start_scoring(&game_state.hard_search, &board, false,
+                                     HARD_NODE_BUDGET);
+          ponder->searching = true;
+        }
+      }
+      if (ponder->searching) {
+        double left_ms = slice_end_ms - timer_now_ms();
+        if (left_ms <= 0) return false;
+        if (expert) {
+          if (!mcts_step(&game_state.search, 0, left_ms)) return false;
+          reply = mcts_result(&game_state.search);
+        } else {
+          MinimaxTask* task = &game_state.hard_search;
+          if (!minimax_task_step(task, 0, left_ms)) return false;
+          reply = hard_move(task, &board, &game_state.ponder_rng);
+        }
+        ponder->searching = false;
+      }
+    }
+
+    if (reply.row >= 0) {
+      ponder->keys[ponder->num_replies] = board.hash;
+      ponder->replies[ponder->num_replies] = reply;
+      ponder->num_replies++;
+    }
+    ponder->next_move++;
+    if (timer_now_ms() >= slice_end_ms) break;
+  }
+  return !ponder->active || ponder->next_move >= ponder->num_moves;
+}
+
+bool take_pondered_move(Cell* move) {
+  if (!game_state_initialised || !move) return false;
+  const PonderCache* ponder = &game_state.ponder;
+  if (!ponder->active) return false;
+
+  for (int i = 0; i < ponder->num_replies; i++) {
+    if (ponder->keys[i] == game_state.board.hash) {
+      *move = ponder->replies[i];
+      return true;
+    }
+  }
+  return false;
+}
 
-  // Imperfect minimax for hard difficulty
-  return minimax_find_move(&game_state.board, true);
+void cancel_ponder() {
+  if (!game_state_initialised) return;
+  game_state.ponder.active = false;
+  game_state.ponder.searching = false;
 }
 
 int reset_scoreboard() {
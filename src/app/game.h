@@ -4,8 +4,19 @@
 #include <gtk/gtk.h>
 
 #include "../shared/board.h"
+#include "../shared/mcts.h"
 #include "../shared/minimax.h"
 #include "../shared/naive_bayes.h"
+#include "../shared/nb_quantized.h"
+
+// Softmax temperature of the hard AI over the minimax scores of its moves
+#define HARD_TEMPERATURE 3.0
+// Nodes the hard AI searches per move, which sets its strength. The opening
+// would take up to 9147 nodes, so it is searched only as deep as this allows
+#define HARD_NODE_BUDGET 4000
+// Playouts of the expert AI per move, and a time limit in case they are slow
+#define EXPERT_PLAYOUTS 5000
+#define EXPERT_TIME_LIMIT_MS 200
 
 typedef enum {
   MODE_1_PLAYER,
@@ -17,8 +28,22 @@ typedef enum {
   DIFF_EASY,
   DIFF_MEDIUM,
   DIFF_HARD,
+  DIFF_EXPERT,
 } DifficultyLevel;
 
+/* AI replies worked out while the human is thinking, see step_ponder() */
+typedef struct {
+  bool active;
+  Cell moves[SIZE * SIZE];  // Human moves to work out a reply to
+  int num_moves;
+  int next_move;   // Index of the human move being worked on
+  bool searching;  // The hard or expert search of the next move is running
+  // Board hash after each human move replied to so far, and the reply
+  uint64_t keys[SIZE * SIZE];
+  Cell replies[SIZE * SIZE];
+  int num_replies;
+} PonderCache;
+
 typedef struct {
   GameMode mode;
   DifficultyLevel difficulty;
@@ -27,6 +52,19 @@ typedef struct {
   GameStats stats;
   GtkBuilder* builder;
   NaiveBayesModel* nb_model;
+  // The model in fixed point, which the medium AI plays with
+  NaiveBayesQuantized nb_quantized;
+  Rng rng;
+  // Separate stream for pondering, so it leaves the moves played unchanged
+  Rng ponder_rng;
+  // Node storage of the expert AI, sized for EXPERT_PLAYOUTS
+  MctsArena arena;
+  // Search of the expert AI while it is thinking or pondering
+  MctsSearch search;
+  // Search of the hard AI while it is thinking or pondering, scoring moves
+  MinimaxTask hard_search;
+  bool ai_thinking;
+  PonderCache ponder;
 } GameState;
 
 /**
@@ -70,6 +108,62 @@ int set_difficulty(DifficultyLevel difficulty);
  */
 Cell get_ai_move();
 
+/**
+ * @brief Start choosing the AI move, to be finished by step_ai_move().
+ *
+ * Difficulties that take long to choose search a slice at a time, so the
+ * main loop keeps running in between.
+ *
+ * @return 0 on success, -1 if game state is not initialised.
+ */
+int start_ai_move();
+
+/**
+ * @brief Continue choosing the AI move started by start_ai_move().
+ * @param max_ms Milliseconds to think for before returning.
+ * @param move Pointer to store the chosen move once it is ready.
+ * @return true if the move is ready, false if this must be called again.
+ */
+bool step_ai_move(double max_ms, Cell* move);
+
+/**
+ * @brief Stop choosing the AI move, e.g. because the board was reset.
+ */
+void cancel_ai_move();
+
+/**
+ * @brief Start working out the AI reply to every move the human can make.
+ *
+ * Call when it is the human's turn, then step_ponder() while waiting for the
+ * click. Only the hard and expert AIs ponder, as the others answer at once.
+ * Their searches are shared with step_ai_move(), so the AI must not be
+ * thinking at the same time.
+ *
+ * @return 0 on success, -1 if game state is not initialised, the game is
+ * over or the AI does not ponder.
+ */
+int start_ponder();
+
+/**
+ * @brief Continue working out the replies started by start_ponder().
+ * @param max_ms Milliseconds to think for before returning.
+ * @return true once every reply is ready, false if this must be called again.
+ */
+bool step_ponder(double max_ms);
+
+/**
+ * @brief Get the reply worked out for the current board, if there is one.
+ * @param move Pointer to store the AI move.
+ * @return true if the reply was found, false if it must be searched for.
+ */
+bool take_pondered_move(Cell* move);
+
+/**
+ * @brief Stop pondering and forget its replies, e.g. because the board or the
+ * difficulty changed.
+ */
+void cancel_ponder();
+
 /**
  * @brief Reset the scoreboard stats to zero.
  * @return 0 on success, -1 if game state is not initialised.
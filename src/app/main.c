@@ -6,7 +6,6 @@
  */
 #include <gtk/gtk.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "audio.h"
 #include "board_gui.h"
@@ -97,9 +96,6 @@ static void gui_activate(GtkApplication* app,
  * @return EXIT_SUCCESS on successful run, EXIT_FAILURE on error.
  */
 int main(int argc, char* argv[]) {
-  // Seed RNG
-  srand((unsigned int)time(NULL));
-
   // Load the Naive Bayes model
   int nb_res;
 #ifdef EMBED_NB_MODEL
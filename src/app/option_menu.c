@@ -62,6 +62,16 @@ static void set_diff_hard(GtkStack* stack) {
   gtk_stack_set_visible_child_name(stack, "player_select");
 }
 
+/**
+ * @brief Handle Expert difficulty selection.
+ * @param stack Pointer to the GtkStack.
+ */
+static void set_diff_expert(GtkStack* stack) {
+  play_sound(SOUND_CLICK);
+  set_difficulty(DIFF_EXPERT);
+  gtk_stack_set_visible_child_name(stack, "player_select");
+}
+
 void update_ai_hint_visibility(GtkBuilder* builder) {
   const GameState* game_state = get_game_state();
   if (!game_state || !builder) return;
@@ -97,7 +107,9 @@ void difficulty_select(GtkBuilder* builder, GtkStack* stack) {
       GTK_WIDGET(gtk_builder_get_object(builder, "diff_medium"));
   GtkWidget* hard_button =
       GTK_WIDGET(gtk_builder_get_object(builder, "diff_hard"));
-  if (!easy_button || !medium_button || !hard_button) {
+  GtkWidget* expert_button =
+      GTK_WIDGET(gtk_builder_get_object(builder, "diff_expert"));
+  if (!easy_button || !medium_button || !hard_button || !expert_button) {
     g_printerr("Could not find difficulty selection buttons.\n");
     return;
   }
@@ -108,4 +120,6 @@ void difficulty_select(GtkBuilder* builder, GtkStack* stack) {
                            G_CALLBACK(set_diff_medium), stack);
   g_signal_connect_swapped(hard_button, "clicked", G_CALLBACK(set_diff_hard),
                            stack);
+  g_signal_connect_swapped(expert_button, "clicked",
+                           G_CALLBACK(set_diff_expert), stack);
 }
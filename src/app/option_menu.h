@@ -23,8 +23,8 @@ void player_select(GtkBuilder* builder, GtkStack* stack);
 /**
  * @brief Initialise difficulty selection UI and connect signals.
  *
- * Sets up the difficulty selection components for choosing easy, medium, or
- * hard difficulty.
+ * Sets up the difficulty selection components for choosing easy, medium, hard
+ * or expert difficulty.
  *
  * @param builder Pointer to the GtkBuilder.
  * @param stack Pointer to the GtkStack.
@@ -7,25 +7,69 @@
 #include "benchmark.h"
 
 #include <float.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #include "../shared/board.h"
+#include "../shared/board_batch.h"
+#include "../shared/hybrid.h"
+#include "../shared/mcts.h"
 #include "../shared/minimax.h"
 #include "../shared/naive_bayes.h"
+#include "../shared/nb_batch.h"
+#include "../shared/perfect_table.h"
+#include "../shared/timer.h"
+#include "../shared/transposition.h"
+#include "dataset.h"
 
 /* Algorithms to benchmark */
 static BenchmarkAlgorithm algorithms[] = {
     {"Random", RANDOM},
     {"Minimax Perfect", MINIMAX},
+    {"Minimax Unordered", MINIMAX_UNORDERED},
+    {"Minimax Resumable", MINIMAX_RESUMABLE},
     {"Minimax Imperfect", MINIMAX_IMPERFECT},
+    {"Minimax Softmax", MINIMAX_SOFTMAX},
+    {"Softmax Budget", MINIMAX_SOFTMAX_BUDGET},
+    {"Minimax TT", MINIMAX_TT},
+    {"Minimax Deadline", MINIMAX_DEADLINE},
+    {"Minimax Budget", MINIMAX_BUDGET},
+    {"Minimax Bitboard", MINIMAX_BITBOARD},
+    {"MCTS", MCTS},
+    {"Perfect Table", PERFECT_TABLE},
     {"Naive Bayes", NAIVE_BAYES},
+    {"Naive Bayes Bitboard", NAIVE_BAYES_BITBOARD},
+    {"Depth-Limited", DEPTH_LIMITED},
+    {"Hybrid", HYBRID},
 };
 
+/* Thread counts of the parallel search benchmark */
+static const int parallel_threads[] = {1, 2, 4, 8};
+#define NUM_PARALLEL_RESULTS \
+  (sizeof(parallel_threads) / sizeof(parallel_threads[0]))
+
 /* Global Naive Bayes model */
 static NaiveBayesModel model;
 
+/* Transposition table kept across every game of an algorithm's benchmark */
+static TranspositionTable tt;
+
+/* Node storage of the MCTS engine, reused by every search */
+static MctsArena arena;
+
+/**
+ * @brief Check whether an algorithm needs the transposition table.
+ * @param algorithm Algorithm to check.
+ * @return true if the algorithm uses the transposition table.
+ */
+static bool uses_tt(Algorithm algorithm) {
+  return algorithm == MINIMAX_TT || algorithm == MINIMAX_DEADLINE;
+}
+
 /**
  * @brief Initialise a BenchmarkResult structure.
  * @param algorithm Algorithm to benchmark.
@@ -38,6 +82,9 @@ static void init_result(Algorithm algorithm, const char* algorithm_name,
   result->algorithm_name = algorithm_name;
   result->win_rate = 0.0;
   result->draw_rate = 0.0;
+  result->optimal_rate = 0.0;
+  memset(&result->search_stats, 0, sizeof(result->search_stats));
+  result->searches = 0;
   for (int i = 0; i < MAX_MOVES; i++) {
     result->moves_left_result[i].total_time = 0.0;
     result->moves_left_result[i].avg_time = 0.0;
@@ -46,9 +93,140 @@ static void init_result(Algorithm algorithm, const char* algorithm_name,
   }
 }
 
+/**
+ * @brief Seed the random number generator of a benchmark.
+ *
+ * Every algorithm draws from its own stream, so its results do not depend on
+ * which other algorithms ran before it.
+ *
+ * @param algorithm Algorithm being benchmarked.
+ * @param rng Pointer to the Rng structure to seed.
+ */
+static void seed_benchmark(Algorithm algorithm, Rng* rng) {
+  // Stream 0 is used by the dataset shuffle
+  rng_seed(rng, DATASET_SHUFFLE_SEED, (uint64_t)algorithm + 1);
+}
+
+/**
+ * @brief Get the move chosen by a specific algorithm.
+ * @param algorithm Algorithm to use.
+ * @param board Pointer to the Board structure.
+ * @param rng Pointer to the random number generator.
+ * @param stats Pointer to store the search counters of minimax algorithms. Can
+ * be NULL if not needed.
+ * @return Cell The selected move.
+ */
+static Cell find_move(Algorithm algorithm, const Board* board, Rng* rng,
+                      SearchStats* stats) {
+  BitBoard bitboard;
+  double scores[SIZE * SIZE];
+  MinimaxTask task;
+  SearchOptions options = {
+      .handicap = false,
+      .rng = rng,
+      .tt = NULL,
+      .stats = stats,
+  };
+  MctsOptions mcts_options = {
+      .rng = rng,
+      .arena = &arena,
+      .playouts = BENCHMARK_MCTS_PLAYOUTS,
+  };
+  switch (algorithm) {
+    case MINIMAX:
+      return minimax_search(board, &options);
+    case MINIMAX_UNORDERED:
+      options.unordered = true;
+      return minimax_search(board, &options);
+    case MINIMAX_RESUMABLE:
+      // Step in small slices, as the GUI does between frames
+      minimax_task_start(&task, board, false, NULL);
+      while (!minimax_task_step(&task, BENCHMARK_SLICE_NODES, 0)) {
+      }
+      return minimax_task_result(&task);
+    case MINIMAX_IMPERFECT:
+      options.handicap = true;
+      return minimax_search(board, &options);
+    case MINIMAX_SOFTMAX:
+      // Weaken play by sampling over the scores instead of sampling moves
+      minimax_score_moves(board, &options, scores);
+      return softmax_scored_move(scores, BENCHMARK_TEMPERATURE, rng);
+    case MINIMAX_SOFTMAX_BUDGET:
+      // The hard difficulty of the GUI, deepened until the budget is spent
+      minimax_task_start_scoring(&task, board, false,
+                                 BENCHMARK_SCORING_BUDGET);
+      minimax_task_step(&task, 0, 0);
+      minimax_task_scores(&task, scores);
+      return softmax_scored_move(scores, BENCHMARK_TEMPERATURE, rng);
+    case MINIMAX_TT:
+      options.tt = &tt;
+      return minimax_search(board, &options);
+    case MINIMAX_DEADLINE:
+      options.tt = &tt;
+      options.time_limit_ms = BENCHMARK_TIME_LIMIT_MS;
+      return minimax_search(board, &options);
+    case MINIMAX_BUDGET:
+      options.node_budget = BENCHMARK_NODE_BUDGET;
+      return minimax_search(board, &options);
+    case MINIMAX_BITBOARD:
+      board_to_bitboard(board, &bitboard);
+      return minimax_find_move_bb(&bitboard, board->current_player, false,
+                                  NULL);
+    case MCTS:
+      return mcts_find_move(board, &mcts_options);
+    case PERFECT_TABLE:
+      return table_find_move(board);
+    case NAIVE_BAYES:
+      return nb_find_move(board, &model);
+    case NAIVE_BAYES_BITBOARD:
+      board_to_bitboard(board, &bitboard);
+      return nb_find_move_bb(&bitboard, board->current_player, &model);
+    case DEPTH_LIMITED:
+      // The hybrid search without the model, its leaves score as draws
+      return hybrid_find_move(board, BENCHMARK_HYBRID_DEPTH, NULL);
+    case HYBRID:
+      return hybrid_find_move(board, BENCHMARK_HYBRID_DEPTH, &model);
+    case RANDOM:
+    default:
+      return random_move(board, rng);
+  }
+}
+
+/**
+ * @brief Check whether an algorithm reports minimax search counters.
+ * @param algorithm Algorithm to check.
+ * @return true if the algorithm fills in SearchStats.
+ */
+static bool reports_stats(Algorithm algorithm) {
+  return algorithm == MINIMAX || algorithm == MINIMAX_UNORDERED ||
+         algorithm == MINIMAX_IMPERFECT || algorithm == MINIMAX_SOFTMAX ||
+         algorithm == MINIMAX_TT || algorithm == MINIMAX_DEADLINE ||
+         algorithm == MINIMAX_BUDGET;
+}
+
+/**
+ * @brief Add the counters of one search to the totals of a benchmark.
+ * @param result Pointer to BenchmarkResult structure to update.
+ * @param stats Pointer to the SearchStats structure of the search.
+ */
+static void add_search_stats(BenchmarkResult* result,
+                             const SearchStats* stats) {
+  SearchStats* total = &result->search_stats;
+  total->nodes += stats->nodes;
+  total->terminal_nodes += stats->terminal_nodes;
+  total->tt_hits += stats->tt_hits;
+  total->researches += stats->researches;
+  for (int m = 0; m < SIZE * SIZE; m++) total->cutoffs[m] += stats->cutoffs[m];
+  if (stats->max_depth > total->max_depth) total->max_depth = stats->max_depth;
+  // Weighted by nodes so tiny searches answered by the table do not dominate,
+  // and divided by the total nodes when printed
+  total->branching_factor += stats->branching_factor * stats->nodes;
+  result->searches++;
+}
+
 /**
  * @brief Benchmark the win rate of a specific algorithm against a random
- * opponent.
+ * opponent, and check its moves against the perfect play table.
  * @param result Pointer to BenchmarkResult structure to store results.
  */
 static void benchmark_win(BenchmarkResult* result) {
@@ -58,6 +236,12 @@ static void benchmark_win(BenchmarkResult* result) {
   const char* algorithm_name = result->algorithm_name;
   int wins = 0;
   int draws = 0;
+  int ai_moves = 0;
+  int optimal_moves = 0;
+  Rng rng;
+  seed_benchmark(algorithm, &rng);
+  // Start every algorithm with an empty table so timings are comparable
+  if (uses_tt(algorithm)) tt_clear(&tt);
 
   for (int i = 0; i < RUNS; i++) {
     // Alternate opponent every run and starting player every two runs
@@ -71,23 +255,12 @@ static void benchmark_win(BenchmarkResult* result) {
       Cell move;
       if (board.current_player == random_player) {
         // Random opponent move
-        move = random_move(&board);
+        move = random_move(&board, &rng);
       } else {
         // AI move based on algorithm
-        switch (algorithm) {
-          case RANDOM:
-            move = random_move(&board);
-            break;
-          case MINIMAX:
-            move = minimax_find_move(&board, false);
-            break;
-          case MINIMAX_IMPERFECT:
-            move = minimax_find_move(&board, true);
-            break;
-          case NAIVE_BAYES:
-            move = nb_find_move(&board, &model);
-            break;
-        }
+        move = find_move(algorithm, &board, &rng, NULL);
+        ai_moves++;
+        if (table_move_is_optimal(&board, &move)) optimal_moves++;
       }
       if (!make_move(&board, &move)) {
         fprintf(stderr, "Warning: Invalid move returned by %s\n",
@@ -109,6 +282,7 @@ static void benchmark_win(BenchmarkResult* result) {
   // Calculate win/draw rate percentage
   result->win_rate = (100.0 * wins) / RUNS;
   result->draw_rate = (100.0 * draws) / RUNS;
+  if (ai_moves > 0) result->optimal_rate = (100.0 * optimal_moves) / ai_moves;
 }
 
 /**
@@ -122,6 +296,9 @@ static void benchmark_response(BenchmarkResult* result) {
   const char* algorithm_name = result->algorithm_name;
   int total_moves[MAX_MOVES] = {0};
   int moves_left;
+  Rng rng;
+  seed_benchmark(algorithm, &rng);
+  if (uses_tt(algorithm)) tt_clear(&tt);
 
   // Perform RUNS games
   for (int i = 0; i < RUNS; i++) {
@@ -130,7 +307,7 @@ static void benchmark_response(BenchmarkResult* result) {
     Board board;
     init_board(&board, starting_player);
     // Randomise the first move to vary starting positions
-    Cell move = random_move(&board);
+    Cell move = random_move(&board, &rng);
     make_move(&board, &move);
     // Run until game over
     while (check_winner(&board, NULL) == ONGOING) {
@@ -138,20 +315,8 @@ static void benchmark_response(BenchmarkResult* result) {
       // Measure start time (ms)
       clock_t start_time = clock();
       // Get AI move based on algorithm
-      switch (algorithm) {
-        case RANDOM:
-          move = random_move(&board);
-          break;
-        case MINIMAX:
-          move = minimax_find_move(&board, false);
-          break;
-        case MINIMAX_IMPERFECT:
-          move = minimax_find_move(&board, true);
-          break;
-        case NAIVE_BAYES:
-          move = nb_find_move(&board, &model);
-          break;
-      }
+      SearchStats stats;
+      move = find_move(algorithm, &board, &rng, &stats);
       // Measure end time (ms)
       clock_t end_time = clock();
       // Validate move
@@ -169,6 +334,7 @@ static void benchmark_response(BenchmarkResult* result) {
       mlr->total_time += elapsed_time;
       if (elapsed_time < mlr->min_time) mlr->min_time = elapsed_time;
       if (elapsed_time > mlr->max_time) mlr->max_time = elapsed_time;
+      if (reports_stats(algorithm)) add_search_stats(result, &stats);
     }
   }
 
@@ -181,18 +347,296 @@ static void benchmark_response(BenchmarkResult* result) {
   }
 }
 
+/**
+ * @brief Play random games that stop after a random number of moves.
+ * @param boards Output array of positions.
+ * @param n Number of positions to generate.
+ * @param rng Pointer to the random number generator.
+ */
+static void random_positions(PackedBoard boards[], size_t n, Rng* rng) {
+  for (size_t i = 0; i < n; i++) {
+    Board board;
+    init_board(&board, (i % 2 == 0) ? PLAYER_X : PLAYER_O);
+    int moves = (int)rng_bounded(rng, MAX_MOVES + 1);
+    for (int j = 0; j < moves && check_winner(&board, NULL) == ONGOING; j++) {
+      Cell move = random_move(&board, rng);
+      make_move(&board, &move);
+    }
+    board_to_bitboard(&board, &boards[i]);
+  }
+}
+
+/**
+ * @brief Benchmark the throughput of checking many boards one at a time
+ * against check_winner_batch.
+ * @param result Pointer to BatchResult structure to store results.
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int benchmark_batch(BatchResult* result) {
+  PackedBoard* boards = malloc(BATCH_BOARDS * sizeof(PackedBoard));
+  Winner* scalar_out = malloc(BATCH_BOARDS * sizeof(Winner));
+  Winner* batch_out = malloc(BATCH_BOARDS * sizeof(Winner));
+  if (!boards || !scalar_out || !batch_out) {
+    fprintf(stderr, "Error: Memory allocation failed\n");
+    free(boards);
+    free(scalar_out);
+    free(batch_out);
+    return -1;
+  }
+  Rng rng;
+  rng_seed(&rng, DATASET_SHUFFLE_SEED, BATCH_STREAM);
+  random_positions(boards, BATCH_BOARDS, &rng);
+
+  clock_t start_time = clock();
+  for (int pass = 0; pass < BATCH_PASSES; pass++) {
+    for (size_t i = 0; i < BATCH_BOARDS; i++) {
+      scalar_out[i] = bb_check_winner(&boards[i]);
+    }
+  }
+  double scalar_time = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+
+  start_time = clock();
+  for (int pass = 0; pass < BATCH_PASSES; pass++) {
+    check_winner_batch(boards, BATCH_BOARDS, batch_out);
+  }
+  double batch_time = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+
+  double total = (double)BATCH_BOARDS * BATCH_PASSES;
+  result->kernel = check_winner_batch_kernel();
+  result->scalar_rate = scalar_time > 0 ? total / scalar_time : 0.0;
+  result->batch_rate = batch_time > 0 ? total / batch_time : 0.0;
+  result->mismatch = NULL;
+  for (size_t i = 0; i < BATCH_BOARDS; i++) {
+    if (scalar_out[i] != batch_out[i]) result->mismatch = "bb_check_winner";
+  }
+
+  free(boards);
+  free(scalar_out);
+  free(batch_out);
+  return 0;
+}
+
+/**
+ * @brief Benchmark the throughput of scoring many boards with naive_bayes()
+ * one at a time against naive_bayes_batch.
+ * @param result Pointer to BatchResult structure to store results. The
+ * results match if the batch is identical to its scalar kernel and within
+ * NB_BATCH_TOLERANCE of nb_log_odds() on every board.
+ * @return 0 on success, -1 on allocation failure.
+ */
+static int benchmark_nb_batch(BatchResult* result) {
+  PackedBoard* boards = malloc(NB_BATCH_BOARDS * sizeof(PackedBoard));
+  Board* expanded = malloc(NB_BATCH_BOARDS * sizeof(Board));
+  float* scalar_out = malloc(NB_BATCH_BOARDS * sizeof(float));
+  float* batch_out = malloc(NB_BATCH_BOARDS * sizeof(float));
+  if (!boards || !expanded || !scalar_out || !batch_out) {
+    fprintf(stderr, "Error: Memory allocation failed\n");
+    free(boards);
+    free(expanded);
+    free(scalar_out);
+    free(batch_out);
+    return -1;
+  }
+  Rng rng;
+  rng_seed(&rng, DATASET_SHUFFLE_SEED, NB_BATCH_STREAM);
+  random_positions(boards, NB_BATCH_BOARDS, &rng);
+  // Expanded up front, so only the scoring itself is timed
+  for (size_t i = 0; i < NB_BATCH_BOARDS; i++) {
+    bitboard_to_board(&boards[i], PLAYER_X, &expanded[i]);
+  }
+
+  clock_t start_time = clock();
+  for (int pass = 0; pass < NB_BATCH_PASSES; pass++) {
+    for (size_t i = 0; i < NB_BATCH_BOARDS; i++) {
+      scalar_out[i] = naive_bayes(&expanded[i], &model);
+    }
+  }
+  double scalar_time = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+
+  start_time = clock();
+  for (int pass = 0; pass < NB_BATCH_PASSES; pass++) {
+    naive_bayes_batch(boards, NB_BATCH_BOARDS, &model, batch_out);
+  }
+  double batch_time = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+
+  double total = (double)NB_BATCH_BOARDS * NB_BATCH_PASSES;
+  result->kernel = naive_bayes_batch_kernel();
+  result->scalar_rate = scalar_time > 0 ? total / scalar_time : 0.0;
+  result->batch_rate = batch_time > 0 ? total / batch_time : 0.0;
+
+  // Every kernel must give the scalar kernel's scores bit for bit
+  result->mismatch = NULL;
+  naive_bayes_batch_scalar(boards, NB_BATCH_BOARDS, &model, scalar_out);
+  if (memcmp(scalar_out, batch_out, NB_BATCH_BOARDS * sizeof(float)) != 0) {
+    result->mismatch = "naive_bayes_batch_scalar";
+  }
+  for (size_t i = 0; i < NB_BATCH_BOARDS && !result->mismatch; i++) {
+    double expected = nb_log_odds(&expanded[i], PLAYER_X, &model);
+    if (fabs(batch_out[i] - expected) >
+        NB_BATCH_TOLERANCE * (1.0 + fabs(expected))) {
+      result->mismatch = "nb_log_odds";
+    }
+  }
+
+  free(boards);
+  free(expanded);
+  free(scalar_out);
+  free(batch_out);
+  return 0;
+}
+
+#ifdef SEARCH_STATS
+/**
+ * @brief Print the minimax search counters in table format.
+ * @param results Array of BenchmarkResult structures.
+ * @param num_results Number of results in the array.
+ */
+static void print_search_stats(const BenchmarkResult results[],
+                               size_t num_results) {
+  printf("\n%-20s %-15s %-15s %-15s %-15s %-15s %-15s %-15s\n", "Algorithm",
+         "Nodes/Move", "Terminal (%)", "TT Hits (%)", "Cutoffs/Move",
+         "1st Cutoff (%)", "Re-search/Move", "Max Depth/EBF");
+  for (size_t i = 0; i < num_results; i++) {
+    const BenchmarkResult* r = &results[i];
+    const SearchStats* s = &r->search_stats;
+    if (r->searches == 0 || s->nodes == 0) continue;
+    unsigned long cutoffs = 0;
+    for (int m = 0; m < SIZE * SIZE; m++) cutoffs += s->cutoffs[m];
+    // Cutoffs on the first move tried show how good the move ordering is
+    double first_cutoff = cutoffs ? 100.0 * s->cutoffs[0] / cutoffs : 0.0;
+    char depth_ebf[32];
+    snprintf(depth_ebf, sizeof(depth_ebf), "%d/%.2f", s->max_depth,
+             s->branching_factor / s->nodes);
+    printf("%-20s %-15.1f %-15.2f %-15.2f %-15.1f %-15.2f %-15.2f %-15s\n",
+           r->algorithm_name, (double)s->nodes / r->searches,
+           100.0 * s->terminal_nodes / s->nodes, 100.0 * s->tt_hits / s->nodes,
+           (double)cutoffs / r->searches, first_cutoff,
+           (double)s->researches / r->searches, depth_ebf);
+  }
+}
+#endif
+
+/**
+ * @brief Play a random game until few enough cells are empty for a full
+ * search, which on a 3x3 board is the empty board itself.
+ * @param board Pointer to the Board structure to fill.
+ * @param rng Pointer to the random number generator.
+ */
+static void parallel_position(Board* board, Rng* rng) {
+  do {
+    init_board(board, PLAYER_X);
+    while (SIZE * SIZE - board->move_count > PARALLEL_MAX_EMPTY &&
+           check_winner(board, NULL) == ONGOING) {
+      Cell move = random_move(board, rng);
+      make_move(board, &move);
+    }
+  } while (check_winner(board, NULL) != ONGOING);
+}
+
+/**
+ * @brief Benchmark the wall time of full searches with different numbers of
+ * threads.
+ *
+ * Each thread count first searches every position once untimed, so the first
+ * count timed does not also pay for cold caches.
+ *
+ * @param results Array of NUM_PARALLEL_RESULTS ParallelResult structures.
+ */
+static void benchmark_parallel(ParallelResult results[]) {
+  Board positions[PARALLEL_POSITIONS];
+  Rng rng;
+  rng_seed(&rng, DATASET_SHUFFLE_SEED, PARALLEL_STREAM);
+  for (int i = 0; i < PARALLEL_POSITIONS; i++) {
+    parallel_position(&positions[i], &rng);
+  }
+
+  for (size_t t = 0; t < NUM_PARALLEL_RESULTS; t++) {
+    // No transposition table, so every search does the full work
+    SearchOptions options = {
+        .handicap = false,
+        .rng = NULL,
+        .tt = NULL,
+        .threads = parallel_threads[t],
+    };
+    for (int i = 0; i < PARALLEL_POSITIONS; i++) {
+      minimax_search(&positions[i], &options);
+    }
+    // Wall time, as CPU time adds up the time of every thread
+    double start_time = timer_now_ms();
+    for (int i = 0; i < PARALLEL_POSITIONS; i++) {
+      minimax_search(&positions[i], &options);
+    }
+    double elapsed_time = timer_now_ms() - start_time;
+
+    results[t].threads = parallel_threads[t];
+    results[t].avg_time = elapsed_time / PARALLEL_POSITIONS;
+    results[t].speedup =
+        (results[t].avg_time > 0) ? results[0].avg_time / results[t].avg_time
+                                  : 0.0;
+  }
+}
+
+/**
+ * @brief Print the parallel search times in table format.
+ * @param results Array of NUM_PARALLEL_RESULTS ParallelResult structures.
+ */
+static void print_parallel_results(const ParallelResult results[]) {
+  printf("\n%-20s %-15s %-15s\n", "Parallel Minimax", "Avg Time (ms)",
+         "Speedup");
+  // Every search is single-threaded then, so the times only differ by noise
+  bool single_threaded = SIZE * SIZE < PARALLEL_MIN_EMPTY;
+  if (single_threaded) {
+    printf("Boards with fewer than %d cells are searched single-threaded\n",
+           PARALLEL_MIN_EMPTY);
+  }
+  for (size_t t = 0; t < NUM_PARALLEL_RESULTS; t++) {
+    char label[32];
+    snprintf(label, sizeof(label), "%d thread%s", results[t].threads,
+             (results[t].threads == 1) ? "" : "s");
+    if (single_threaded) {
+      printf("%-20s %-15.6f %-15s\n", label, results[t].avg_time, "n/a");
+    } else {
+      printf("%-20s %-15.6f %-15.2f\n", label, results[t].avg_time,
+             results[t].speedup);
+    }
+  }
+}
+
+/**
+ * @brief Print the throughput of a batched kernel in table format.
+ * @param title Name of the work done on each board.
+ * @param result Pointer to the BatchResult structure.
+ */
+static void print_batch_result(const char* title, const BatchResult* result) {
+  printf("\n%-20s %-15s %-15s\n", title, "Kernel", "Mboards/s");
+  printf("%-20s %-15s %-15.2f\n", "One at a time", "Scalar",
+         result->scalar_rate / 1e6);
+  printf("%-20s %-15s %-15.2f\n", "Batched", result->kernel,
+         result->batch_rate / 1e6);
+  if (result->mismatch) {
+    fprintf(stderr, "Warning: Batched results differ from %s\n",
+            result->mismatch);
+  }
+}
+
 /**
  * @brief Print the benchmark results in table format.
  * @param results Array of BenchmarkResult structures.
  * @param num_results Number of results in the array.
  */
 static void print_results(const BenchmarkResult results[], size_t num_results) {
-  // Win and Draw Rate
-  printf("%-20s %-15s %-15s\n", "Algorithm", "Win Rate (%)", "Draw Rate (%)");
+  // Win and Draw Rate, and Optimal Moves if the table can judge them
+  printf("%-20s %-15s %-15s %-15s\n", "Algorithm", "Win Rate (%)",
+         "Draw Rate (%)", "Optimal (%)");
   for (size_t i = 0; i < num_results; i++) {
     const BenchmarkResult* r = &results[i];
-    printf("%-20s %-15.2f %-15.2f\n", r->algorithm_name, r->win_rate,
+    printf("%-20s %-15.2f %-15.2f ", r->algorithm_name, r->win_rate,
            r->draw_rate);
+    if (table_available()) {
+      printf("%-15.2f\n", r->optimal_rate);
+    } else {
+      printf("%-15s\n", "-");
+    }
   }
 
   // Response Time
@@ -211,32 +655,83 @@ static void print_results(const BenchmarkResult results[], size_t num_results) {
   }
 }
 
+/**
+ * @brief Check whether an algorithm needs the Naive Bayes model.
+ * @param algorithm Algorithm to check.
+ * @return true if the algorithm uses the Naive Bayes model.
+ */
+static bool uses_model(Algorithm algorithm) {
+  return algorithm == NAIVE_BAYES || algorithm == NAIVE_BAYES_BITBOARD ||
+         algorithm == HYBRID;
+}
+
 int run_benchmarks(const char* model_path) {
   if (!model_path) {
     fprintf(stderr, "Error: Model path is not specified\n");
     return EXIT_FAILURE;
   }
   printf("Loading Naive Bayes model from %s...\n", model_path);
-  if (load_nb_model(&model, model_path) != 0) {
-    fprintf(stderr, "Error: Failed to load model\n");
-    return EXIT_FAILURE;
+  bool model_loaded = load_nb_model(&model, model_path) == 0;
+  if (model_loaded) {
+    printf("Model loaded successfully.\n");
+  } else {
+    // The model only fits the board size it was trained on
+    fprintf(stderr,
+            "Warning: Failed to load model, skipping Naive Bayes "
+            "algorithms\n");
+  }
+
+  bool tt_allocated = tt_init(&tt, TT_DEFAULT_KB) == 0;
+  if (!tt_allocated) {
+    fprintf(stderr, "Warning: Skipping transposition table algorithms\n");
   }
-  printf("Model loaded successfully.\n");
+  bool arena_allocated =
+      mcts_arena_init(&arena, BENCHMARK_MCTS_PLAYOUTS + 1) == 0;
+  if (!arena_allocated) fprintf(stderr, "Warning: Skipping MCTS\n");
 
   // Initialize results array
   size_t num_algorithms = sizeof(algorithms) / sizeof(algorithms[0]);
   BenchmarkResult results[num_algorithms];
+  size_t num_results = 0;
   for (size_t i = 0; i < num_algorithms; i++) {
-    init_result(algorithms[i].algorithm, algorithms[i].name, &results[i]);
+    if (!model_loaded && uses_model(algorithms[i].algorithm)) continue;
+    if (!tt_allocated && uses_tt(algorithms[i].algorithm)) continue;
+    if (!arena_allocated && algorithms[i].algorithm == MCTS) continue;
+    init_result(algorithms[i].algorithm, algorithms[i].name,
+                &results[num_results++]);
   }
 
   printf("Starting benchmarks (%d runs per algorithm)...\n", RUNS);
   printf("Benchmarking Win Rates...\n");
-  for (size_t i = 0; i < num_algorithms; i++) benchmark_win(&results[i]);
+  for (size_t i = 0; i < num_results; i++) benchmark_win(&results[i]);
   printf("Benchmarking Response Times...\n");
-  for (size_t i = 0; i < num_algorithms; i++) benchmark_response(&results[i]);
+  for (size_t i = 0; i < num_results; i++) benchmark_response(&results[i]);
+  printf("Benchmarking Terminal Evaluation...\n");
+  BatchResult batch_result;
+  bool batch_ok = benchmark_batch(&batch_result) == 0;
+  BatchResult nb_batch_result;
+  bool nb_batch_ok = false;
+  if (model_loaded) {
+    printf("Benchmarking Naive Bayes Inference...\n");
+    nb_batch_ok = benchmark_nb_batch(&nb_batch_result) == 0;
+  }
+  printf("Benchmarking Parallel Search...\n");
+  ParallelResult parallel_results[NUM_PARALLEL_RESULTS];
+  benchmark_parallel(parallel_results);
 
   printf("\nBenchmark Results:\n");
-  print_results(results, num_algorithms);
+  print_results(results, num_results);
+#ifdef SEARCH_STATS
+  print_search_stats(results, num_results);
+#endif
+  if (batch_ok) {
+    print_batch_result("Terminal Check", &batch_result);
+  }
+  if (nb_batch_ok) {
+    print_batch_result("Naive Bayes", &nb_batch_result);
+  }
+  print_parallel_results(parallel_results);
+  tt_free(&tt);
+  mcts_arena_free(&arena);
   return EXIT_SUCCESS;
 }
@@ -2,11 +2,51 @@
 #define BENCHMARK_H
 
 #include "../shared/board.h"
+#include "../shared/minimax.h"
 
 #define MAX_MOVES (SIZE * SIZE)
 #define RUNS 5000
+#define BENCHMARK_TIME_LIMIT_MS 0.05  // Deadline of the Minimax Deadline search
+#define BENCHMARK_NODE_BUDGET 32      // Node budget of the Minimax Budget search
+#define BENCHMARK_MCTS_PLAYOUTS 1000  // Playouts per move of the MCTS engine
+#define BENCHMARK_SLICE_NODES 64      // Nodes per step of the resumable search
+#define BENCHMARK_HYBRID_DEPTH 2      // Plies searched by the hybrid engine
+#define BENCHMARK_TEMPERATURE 3.0     // Softmax temperature of Minimax Softmax
+// Node budget of Softmax Budget, the HARD_NODE_BUDGET of the GUI
+#define BENCHMARK_SCORING_BUDGET 4000
+#define BATCH_BOARDS (1 << 20)  // Boards in the terminal evaluation benchmark
+#define BATCH_PASSES 20         // Passes over the boards per method
+#define BATCH_STREAM 0x100      // Rng stream, clear of the algorithm streams
+#define NB_BATCH_STREAM 0x102   // Rng stream of the Naive Bayes batch boards
+// Boards in the Naive Bayes batch benchmark, fewer as each is also expanded
+#define NB_BATCH_BOARDS (1 << 14)
+#define NB_BATCH_PASSES 1280  // As many boards scored as the terminal check
+// Allowed gap between the single precision batch and the double log odds
+#define NB_BATCH_TOLERANCE 1e-4
+#define PARALLEL_POSITIONS 16   // Positions searched per thread count
+// Empty cells left in the searched positions, the fewest searched in parallel
+#define PARALLEL_MAX_EMPTY PARALLEL_MIN_EMPTY
+#define PARALLEL_STREAM 0x101   // Rng stream of the parallel positions
 
-typedef enum { RANDOM, MINIMAX, MINIMAX_IMPERFECT, NAIVE_BAYES } Algorithm;
+typedef enum {
+  RANDOM,
+  MINIMAX,
+  MINIMAX_UNORDERED,
+  MINIMAX_RESUMABLE,
+  MINIMAX_IMPERFECT,
+  MINIMAX_SOFTMAX,
+  MINIMAX_TT,
+  MINIMAX_DEADLINE,
+  MINIMAX_BUDGET,
+  MINIMAX_BITBOARD,
+  MCTS,
+  PERFECT_TABLE,
+  NAIVE_BAYES,
+  NAIVE_BAYES_BITBOARD,
+  DEPTH_LIMITED,
+  HYBRID,
+  MINIMAX_SOFTMAX_BUDGET,
+} Algorithm;
 
 typedef struct {
   const char* name;
@@ -25,9 +65,26 @@ typedef struct {
   const char* algorithm_name;
   float win_rate;
   float draw_rate;
+  float optimal_rate;  // Moves that keep the perfect play outcome
   MovesLeftResult moves_left_result[MAX_MOVES];
+  SearchStats search_stats;  // Totals over the response time benchmark
+  int searches;              // Searches the totals were collected from
 } BenchmarkResult;
 
+typedef struct {
+  const char* kernel;   // Kernel check_winner_batch runs on
+  double scalar_rate;   // Boards per second checked one at a time
+  double batch_rate;    // Boards per second checked by check_winner_batch
+  // What the batched results differ from on some board, NULL if none
+  const char* mismatch;
+} BatchResult;
+
+typedef struct {
+  int threads;
+  double avg_time;  // Wall time per search in milliseconds
+  double speedup;   // Relative to a single thread
+} ParallelResult;
+
 /**
  * @brief Run benchmarks for different algorithms and print results in a table.
  * @param model_path Path to the Naive Bayes model file.
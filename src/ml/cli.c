@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "perft.h"
+
 /**
  * @brief Print usage information for the program.
  * @param progname Name of the program.
@@ -18,14 +20,18 @@
 static void print_usage(const char* progname) {
   printf(
       "Usage:\n"
-      "  %s train [-d <dataset path>] [-m <model path>]\n"
-      "  %s stats [-d <dataset path>] [-m <model path>]\n"
-      "  %s benchmark [-m <model path>]\n",
-      progname, progname, progname);
+      "  %s train [-d <dataset path>] [-m <model path>]"
+      " [-q <quantized model path>]\n"
+      "  %s stats [-d <dataset path>] [-m <model path>]"
+      " [-q <quantized model path>]\n"
+      "  %s benchmark [-m <model path>]\n"
+      "  %s perft [-d <depth>]\n",
+      progname, progname, progname, progname);
 }
 
 int parse_arguments(int argc, char* argv[], ProgramMode* mode,
-                    const char** dataset_path, const char** model_path) {
+                    const char** dataset_path, const char** model_path,
+                    const char** quantized_path, int* perft_depth) {
   if (argc < 2) {
     print_usage(argv[0]);
     return -1;
@@ -38,6 +44,8 @@ int parse_arguments(int argc, char* argv[], ProgramMode* mode,
     *mode = MODE_STATS;
   } else if (strcmp(argv[1], "benchmark") == 0) {
     *mode = MODE_BENCHMARK;
+  } else if (strcmp(argv[1], "perft") == 0) {
+    *mode = MODE_PERFT;
   } else {
     fprintf(stderr, "Error: Invalid mode '%s'\n", argv[1]);
     print_usage(argv[0]);
@@ -47,20 +55,41 @@ int parse_arguments(int argc, char* argv[], ProgramMode* mode,
   // Set defaults
   *dataset_path = DEFAULT_DATASET_PATH;
   *model_path = DEFAULT_MODEL_PATH;
+  *quantized_path = NULL;
+  *perft_depth = PERFT_DEFAULT_DEPTH;
 
   // Reset getopt state for parsing options
   optind = 2;
 
   // Parse options
   int opt;
-  while ((opt = getopt(argc, argv, "d:m:")) != -1) {
+  while ((opt = getopt(argc, argv, "d:m:q:")) != -1) {
     switch (opt) {
       case 'd':
-        *dataset_path = optarg;
+        // Perft has no dataset, so -d sets its depth instead
+        if (*mode == MODE_PERFT) {
+          char* end;
+          long depth = strtol(optarg, &end, 10);
+          if (*end != '\0' || depth < 1 || depth > PERFT_MAX_DEPTH) {
+            fprintf(stderr, "Error: Depth must be between 1 and %d\n",
+                    PERFT_MAX_DEPTH);
+            return -1;
+          }
+          *perft_depth = (int)depth;
+        } else {
+          *dataset_path = optarg;
+        }
         break;
       case 'm':
         *model_path = optarg;
         break;
+      case 'q':
+        if (*mode != MODE_TRAIN && *mode != MODE_STATS) {
+          fprintf(stderr, "Error: -q is only used by train and stats\n");
+          return -1;
+        }
+        *quantized_path = optarg;
+        break;
       default:
         print_usage(argv[0]);
         return -1;
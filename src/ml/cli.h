@@ -4,7 +4,13 @@
 #define DEFAULT_DATASET_PATH "dataset/tic-tac-toe.data"
 #define DEFAULT_MODEL_PATH "artifacts/naive_bayes.bin"
 
-typedef enum { MODE_NONE, MODE_TRAIN, MODE_STATS, MODE_BENCHMARK } ProgramMode;
+typedef enum {
+  MODE_NONE,
+  MODE_TRAIN,
+  MODE_STATS,
+  MODE_BENCHMARK,
+  MODE_PERFT,
+} ProgramMode;
 
 /**
  * @brief Parse command line arguments for the ML program.
@@ -13,9 +19,14 @@ typedef enum { MODE_NONE, MODE_TRAIN, MODE_STATS, MODE_BENCHMARK } ProgramMode;
  * @param mode Pointer to store the program mode.
  * @param dataset_path Pointer to store the dataset path.
  * @param model_path Pointer to store the model path.
+ * @param quantized_path Pointer to store the path of the quantized model,
+ * exported when training and checked against the model by stats, NULL if not
+ * given.
+ * @param perft_depth Pointer to store the perft depth, set by -d in perft mode.
  * @return 0 on success, -1 on error.
  */
 int parse_arguments(int argc, char* argv[], ProgramMode* mode,
-                    const char** dataset_path, const char** model_path);
+                    const char** dataset_path, const char** model_path,
+                    const char** quantized_path, int* perft_depth);
 
 #endif  // ML_CLI_H
@@ -6,6 +6,7 @@
  */
 #include "dataset.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -109,11 +110,11 @@ DataEntry* process_dataset(const char* filepath, size_t* data_entries_size) {
   return data_entries;
 }
 
-int shuffle_dataset(DataEntry* data_entries, size_t size) {
-  if (size < 2) return -1;
+int shuffle_dataset(DataEntry* data_entries, size_t size, Rng* rng) {
+  if (size < 2 || size > UINT32_MAX) return -1;
   // Fisher-Yates shuffle
   for (size_t i = 0; i < size - 1; i++) {
-    size_t j = i + rand() % (size - i);
+    size_t j = i + rng_bounded(rng, (uint32_t)(size - i));
     DataEntry temp = data_entries[j];
     data_entries[j] = data_entries[i];
     data_entries[i] = temp;
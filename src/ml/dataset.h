@@ -7,6 +7,7 @@
 #include "../shared/naive_bayes.h"
 
 #define DATASET_SHUFFLE_SEED 1234  // Fixed seed for reproducibility
+#define DATASET_SHUFFLE_STREAM 0   // RNG stream of the dataset shuffle
 #define MAX_DATASET_LINE_LENGTH 256
 #define TRAINING_SPLIT_RATIO 0.8
 
@@ -28,8 +29,9 @@ DataEntry* process_dataset(const char* filepath, size_t* data_entries_size);
  * @brief Shuffle the dataset entries in place for training/testing split.
  * @param data_entries Pointer to the array of DataEntry structs.
  * @param size Number of entries in the dataset.
+ * @param rng Pointer to the random number generator to shuffle with.
  * @return 0 on success, -1 on failure.
  */
-int shuffle_dataset(DataEntry* data_entries, size_t size);
+int shuffle_dataset(DataEntry* data_entries, size_t size, Rng* rng);
 
 #endif  // DATASET_H
@@ -6,10 +6,12 @@
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "benchmark.h"
 #include "cli.h"
 #include "dataset.h"
+#include "perft.h"
 #include "statistics.h"
 #include "training.h"
 
@@ -17,18 +19,25 @@ int main(int argc, char* argv[]) {
   ProgramMode mode = MODE_NONE;
   const char* dataset_path = NULL;
   const char* model_path = NULL;
+  const char* quantized_path = NULL;
+  int perft_depth = 0;
   // Parse CLI arguments
-  if (parse_arguments(argc, argv, &mode, &dataset_path, &model_path) != 0)
+  if (parse_arguments(argc, argv, &mode, &dataset_path, &model_path,
+                      &quantized_path, &perft_depth) != 0)
     return EXIT_FAILURE;
 
-  srand(DATASET_SHUFFLE_SEED);
-
   // Skip dataset processing for benchmark mode
   if (mode == MODE_BENCHMARK) {
     printf("===== BENCHMARK MODE =====\n");
     return run_benchmarks(model_path);
   }
 
+  // Perft only walks the game tree
+  if (mode == MODE_PERFT) {
+    printf("===== PERFT MODE =====\n");
+    return run_perft(perft_depth);
+  }
+
   // Parse dataset
   printf("Processing dataset: %s\n", dataset_path);
   size_t data_entries_size = 0;
@@ -40,7 +49,9 @@ int main(int argc, char* argv[]) {
   printf("Total number of data entries: %zu\n", data_entries_size);
 
   // Shuffle dataset
-  if (shuffle_dataset(data_entries, data_entries_size) != 0) {
+  Rng rng;
+  rng_seed(&rng, DATASET_SHUFFLE_SEED, DATASET_SHUFFLE_STREAM);
+  if (shuffle_dataset(data_entries, data_entries_size, &rng) != 0) {
     fprintf(stderr, "Error: Failed to shuffle dataset\n");
     free(data_entries);
     return EXIT_FAILURE;
@@ -68,6 +79,17 @@ int main(int argc, char* argv[]) {
       return EXIT_FAILURE;
     }
     printf("Model saved successfully.\n");
+
+    // Export the fixed point model for integer-only inference
+    if (quantized_path != NULL) {
+      printf("Saving quantized model to %s...\n", quantized_path);
+      if (save_quantized_model(&model, quantized_path) != 0) {
+        fprintf(stderr, "Error: Failed to save quantized model\n");
+        free(data_entries);
+        return EXIT_FAILURE;
+      }
+      printf("Quantized model saved successfully.\n");
+    }
   }
 
   if (mode == MODE_STATS) {
@@ -110,6 +132,40 @@ int main(int argc, char* argv[]) {
     printf("Recall: %.4f\n", metrics.recall);
     printf("F1 Score: %.4f\n", metrics.f1_score);
     free((void*)predictions);
+
+    // Compare against the same model rounded to fixed point
+    NaiveBayesQuantized quantized;
+    nb_quantize_model(&model, &quantized);
+    if (quantized_path != NULL) {
+      // An exported model must read back as exactly the rounded tables
+      printf("\nLoading quantized model from %s...\n", quantized_path);
+      NaiveBayesQuantized exported;
+      if (load_nb_quantized(&exported, quantized_path) != 0 ||
+          memcmp(&exported, &quantized, sizeof(quantized)) != 0) {
+        fprintf(stderr,
+                "Error: Quantized model does not match the model rounded to "
+                "fixed point\n");
+        free(data_entries);
+        return EXIT_FAILURE;
+      }
+      printf("Quantized model matches the model.\n");
+    }
+    predictions = evaluate_quantized_model(&data_entries[training_split],
+                                           testing_split, &quantized);
+    if (predictions == NULL) {
+      fprintf(stderr, "Error: Failed to evaluate quantized model\n");
+      free(data_entries);
+      return EXIT_FAILURE;
+    }
+    Metrics quantized_metrics = calculate_metrics(
+        calculate_confusion_matrix(predictions, testing_split));
+    printf("\n===== Quantized Model =====\n");
+    printf("Size: %zu bytes (%zu bytes in double precision)\n",
+           sizeof(NaiveBayesQuantized), (size_t)NB_MODEL_FILE_SIZE);
+    printf("Accuracy: %.4f (%+.4f against double precision)\n",
+           quantized_metrics.accuracy,
+           quantized_metrics.accuracy - metrics.accuracy);
+    free((void*)predictions);
   }
 
   free(data_entries);
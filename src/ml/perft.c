@@ -0,0 +1,104 @@
+/**
+ * @file perft.c
+ * @brief Enumerates the game tree to measure and check the board primitives.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "perft.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Known counts of the full 3x3 game tree, indexed by ply */
+static const uint64_t EXPECTED_NODES[10] = {1,     9,      72,     504,    3024,
+                                            15120, 54720, 148176, 200448, 127872};
+static const uint64_t EXPECTED_GAMES[10] = {0,    0,     0,     0,     0,
+                                            1440, 5328, 47952, 72576, 127872};
+#define EXPECTED_TOTAL_GAMES 255168
+
+/**
+ * @brief Count the positions and finished games below a board.
+ * @param board Pointer to the Board structure, restored before returning.
+ * @param depth Ply to stop walking at.
+ * @param result Pointer to PerftResult structure to add the counts to.
+ */
+static void walk(Board* board, int depth, PerftResult* result) {
+  int ply = board->move_count;
+  result->nodes[ply]++;
+  if (check_winner(board, NULL) != ONGOING) {
+    result->games[ply]++;
+    return;
+  }
+  if (ply == depth) return;
+
+  Cell moves[SIZE * SIZE];
+  int num_moves = find_empty_cells(board, moves, SIZE * SIZE);
+  for (int i = 0; i < num_moves; i++) {
+    make_move(board, &moves[i]);
+    walk(board, depth, result);
+    undo_move(board);
+  }
+}
+
+int perft(int depth, PerftResult* result) {
+  if (!result || depth < 1 || depth > PERFT_MAX_DEPTH) return -1;
+
+  // Repeat the walk until the timing is long enough to be meaningful
+  uint64_t total_nodes = 0;
+  double elapsed = 0.0;
+  clock_t start_time = clock();
+  do {
+    memset(result, 0, sizeof(*result));
+    result->depth = depth;
+    Board board;
+    init_board(&board, PLAYER_X);
+    walk(&board, depth, result);
+    for (int ply = 0; ply <= depth; ply++) total_nodes += result->nodes[ply];
+    elapsed = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+  } while (elapsed < PERFT_MIN_TIME);
+
+  result->nodes_per_sec = total_nodes / elapsed;
+  return 0;
+}
+
+int run_perft(int depth) {
+  PerftResult result;
+  printf("Walking the game tree to depth %d...\n", depth);
+  if (perft(depth, &result) != 0) {
+    fprintf(stderr, "Error: Depth must be between 1 and %d\n",
+            PERFT_MAX_DEPTH);
+    return EXIT_FAILURE;
+  }
+
+  // The known counts only apply to the standard board
+  bool checkable = SIZE == 3 && WIN_LENGTH == 3;
+  bool passed = true;
+  uint64_t total_nodes = 0;
+  uint64_t total_games = 0;
+  printf("\n%-8s %-15s %-15s\n", "Ply", "Nodes", "Games Ended");
+  for (int ply = 0; ply <= depth; ply++) {
+    printf("%-8d %-15" PRIu64 " %-15" PRIu64 "\n", ply, result.nodes[ply],
+           result.games[ply]);
+    total_nodes += result.nodes[ply];
+    total_games += result.games[ply];
+    if (checkable && (result.nodes[ply] != EXPECTED_NODES[ply] ||
+                      result.games[ply] != EXPECTED_GAMES[ply])) {
+      passed = false;
+    }
+  }
+  printf("%-8s %-15" PRIu64 " %-15" PRIu64 "\n", "Total", total_nodes,
+         total_games);
+  printf("\nNodes per second: %.0f\n", result.nodes_per_sec);
+
+  if (!checkable) return EXIT_SUCCESS;
+  if (depth == PERFT_MAX_DEPTH && total_games != EXPECTED_TOTAL_GAMES) {
+    passed = false;
+  }
+  printf("Check against the known 3x3 game tree: %s\n",
+         passed ? "PASS" : "FAIL");
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
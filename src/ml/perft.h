@@ -0,0 +1,37 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <stdint.h>
+
+#include "../shared/board.h"
+
+#define PERFT_MAX_DEPTH (SIZE * SIZE)
+// Default depth, the full tree on 3x3 but bounded on larger boards
+#define PERFT_DEFAULT_DEPTH (PERFT_MAX_DEPTH <= 9 ? PERFT_MAX_DEPTH : 7)
+#define PERFT_MIN_TIME 0.5  // Seconds to repeat the walk for for timing
+
+typedef struct {
+  int depth;
+  uint64_t nodes[PERFT_MAX_DEPTH + 1];  // Positions reached at each ply
+  uint64_t games[PERFT_MAX_DEPTH + 1];  // Games that ended at each ply
+  double nodes_per_sec;
+} PerftResult;
+
+/**
+ * @brief Walk every move sequence up to a depth and count the positions and
+ * finished games at each ply.
+ * @param depth Number of plies to walk, 1 to PERFT_MAX_DEPTH.
+ * @param result Pointer to PerftResult structure to store results.
+ * @return 0 on success, -1 on invalid parameters.
+ */
+int perft(int depth, PerftResult* result);
+
+/**
+ * @brief Run perft, print the counts per ply and the walk speed, and check the
+ * counts against the known 3x3 game tree.
+ * @param depth Number of plies to walk, 1 to PERFT_MAX_DEPTH.
+ * @return EXIT_SUCCESS if the counts are correct, EXIT_FAILURE otherwise.
+ */
+int run_perft(int depth);
+
+#endif  // PERFT_H
@@ -11,6 +11,25 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../shared/nb_batch.h"
+
+/**
+ * @brief Pack the cells of a data entry into a bitboard.
+ * @param entry Pointer to the DataEntry structure.
+ * @param board Pointer to the PackedBoard to fill.
+ */
+static void pack_entry(const DataEntry* entry, PackedBoard* board) {
+  board->x = 0;
+  board->o = 0;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      BitMask bit = BB_BIT(row * SIZE + col);
+      if (entry->cells[row][col] == X) board->x |= bit;
+      if (entry->cells[row][col] == O) board->o |= bit;
+    }
+  }
+}
+
 Prediction* evaluate_model(const DataEntry* data_entries,
                            const size_t data_entries_size,
                            const NaiveBayesModel* model) {
@@ -22,17 +41,46 @@ Prediction* evaluate_model(const DataEntry* data_entries,
     return NULL;
   }
 
+  // Score the entries a chunk at a time with the batched kernel
+  PackedBoard boards[EVALUATE_CHUNK];
+  float scores[EVALUATE_CHUNK];
+  for (size_t start = 0; start < data_entries_size; start += EVALUATE_CHUNK) {
+    size_t count = data_entries_size - start;
+    if (count > EVALUATE_CHUNK) count = EVALUATE_CHUNK;
+    for (size_t i = 0; i < count; i++) {
+      pack_entry(&data_entries[start + i], &boards[i]);
+    }
+    naive_bayes_batch(boards, count, model, scores);
+
+    // Assign actual and predicted outcomes, positive at even log odds or more
+    for (size_t i = 0; i < count; i++) {
+      predictions[start + i].actual = data_entries[start + i].outcome;
+      predictions[start + i].prediction =
+          (scores[i] >= 0) ? POSITIVE : NEGATIVE;
+    }
+  }
+
+  return predictions;
+}
+
+Prediction* evaluate_quantized_model(const DataEntry* data_entries,
+                                     const size_t data_entries_size,
+                                     const NaiveBayesQuantized* quantized) {
+  if (!data_entries || !quantized || data_entries_size == 0) return NULL;
+
+  Prediction* predictions =
+      (Prediction*)malloc(data_entries_size * sizeof(Prediction));
+  if (!predictions) {
+    return NULL;
+  }
+
+  // The model scores the cells only, so the rest of the board is not set up
+  Board board;
   for (size_t i = 0; i < data_entries_size; i++) {
-    // Copy cells to board structure
-    Board board;
-    // Use memcpy to copy the entire cell grid efficiently
     memcpy(board.cells, data_entries[i].cells, sizeof(board.cells));
-
-    // Predict outcome using the Naive Bayes model
-    float prob = naive_bayes(&board, model);
-    // Assign actual and predicted outsomes
+    int32_t score = nb_quantized_log_odds(&board, PLAYER_X, quantized);
     predictions[i].actual = data_entries[i].outcome;
-    predictions[i].prediction = (prob >= 0) ? POSITIVE : NEGATIVE;
+    predictions[i].prediction = (score >= 0) ? POSITIVE : NEGATIVE;
   }
 
   return predictions;
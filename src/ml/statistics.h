@@ -4,8 +4,11 @@
 #include <stddef.h>
 
 #include "../shared/naive_bayes.h"
+#include "../shared/nb_quantized.h"
 #include "dataset.h"
 
+#define EVALUATE_CHUNK 1024  // Entries packed and scored per batch
+
 typedef struct {
   int tp;
   int tn;
@@ -37,6 +40,18 @@ Prediction* evaluate_model(const DataEntry* data_entries,
                            const size_t data_entries_size,
                            const NaiveBayesModel* model);
 
+/**
+ * @brief Evaluate the quantized Naive Bayes model on the given dataset.
+ * @param data_entries Pointer to an array of DataEntry structs.
+ * @param data_entries_size Number of entries in the dataset.
+ * @param quantized Pointer to the quantized Naive Bayes model.
+ * @return Pointer to an array of Prediction structs containing actual and
+ * predicted outcomes (same size as data_entries_size).
+ */
+Prediction* evaluate_quantized_model(const DataEntry* data_entries,
+                                     const size_t data_entries_size,
+                                     const NaiveBayesQuantized* quantized);
+
 /**
  * @brief Calculate the confusion matrix from the predictions.
  * @param predictions Pointer to an array of Prediction structs.
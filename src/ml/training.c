@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "../shared/model_file.h"
+
 NaiveBayesModel train_model(const DataEntry* data_entries,
                             const size_t data_entries_size) {
   NaiveBayesModel model;
@@ -58,25 +60,19 @@ NaiveBayesModel train_model(const DataEntry* data_entries,
     }
   }
 
+  nb_prepare_model(&model);
   return model;
 }
 
 int save_model(const NaiveBayesModel* model, const char* model_path) {
-  FILE* fp = fopen(model_path, "wb");
-  if (fp == NULL) {
-    fprintf(stderr, "Error: Failed to open output file path '%s'\n",
-            model_path);
-    return -1;
-  }
-
-  size_t written = fwrite(model, sizeof(NaiveBayesModel), 1, fp);
-  fclose(fp);
-
-  if (written != 1) {
-    fprintf(stderr, "Error: Failed to write model to file path '%s'\n",
-            model_path);
-    return -1;
-  }
+  // Only the probabilities are saved, the log tables are derived on load
+  return model_file_write(model_path, MODEL_NAIVE_BAYES, MODEL_F64, model,
+                          NB_MODEL_FILE_SIZE);
+}
 
-  return 0;
+int save_quantized_model(const NaiveBayesModel* model, const char* model_path) {
+  NaiveBayesQuantized quantized;
+  nb_quantize_model(model, &quantized);
+  return model_file_write(model_path, MODEL_NAIVE_BAYES_QUANTIZED, MODEL_I16,
+                          &quantized, sizeof(quantized));
 }
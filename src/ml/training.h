@@ -4,11 +4,12 @@
 #include <stddef.h>
 
 #include "../shared/naive_bayes.h"
+#include "../shared/nb_quantized.h"
 #include "dataset.h"
 
 // OUTCOME and STATE are defined in naive_bayes.h
 #define ALPHA 1.0   // Laplace smoothing factor
-#define FEATURES 9  // 3x3 Tic-Tac-Toe board has 9 features
+#define FEATURES (SIZE * SIZE)  // One feature per cell
 
 /**
  * @brief Trains a Naive Bayes classifier for Tic-Tac-Toe using the provided
@@ -23,11 +24,21 @@ NaiveBayesModel train_model(const DataEntry* data_entries,
                             const size_t data_entries_size);
 
 /**
- * @brief Saves the trained Naive Bayes model (struct) to a binary file.
+ * @brief Saves the trained Naive Bayes model to a model file, see
+ * model_file.h.
  * @param model Pointer to the Naive Bayes model.
  * @param model_path Path to the output binary file.
  * @return int 0 on success, -1 on failure.
  */
 int save_model(const NaiveBayesModel* model, const char* model_path);
 
+/**
+ * @brief Saves the trained Naive Bayes model in 16-bit fixed point, for
+ * integer-only inference with nb_quantized_log_odds().
+ * @param model Pointer to the Naive Bayes model.
+ * @param model_path Path to the output binary file.
+ * @return int 0 on success, -1 on failure.
+ */
+int save_quantized_model(const NaiveBayesModel* model, const char* model_path);
+
 #endif  // TRAINING_H
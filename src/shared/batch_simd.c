@@ -0,0 +1,36 @@
+/**
+ * @file batch_simd.c
+ * @brief CPU dispatch shared by the batched kernels.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+#include "batch_simd.h"
+
+#include <stdbool.h>
+
+BatchIsa batch_isa(void) {
+  static bool checked = false;
+  static BatchIsa isa = BATCH_ISA_SCALAR;
+  if (checked) return isa;
+
+#ifdef BATCH_SIMD
+#ifdef __SSE2__
+  isa = BATCH_ISA_SSE2;
+#endif
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) isa = BATCH_ISA_AVX2;
+#endif
+  checked = true;
+  return isa;
+}
+
+const char* batch_isa_name(BatchIsa isa) {
+  switch (isa) {
+    case BATCH_ISA_AVX2:
+      return "AVX2";
+    case BATCH_ISA_SSE2:
+      return "SSE2";
+    default:
+      return "Scalar";
+  }
+}
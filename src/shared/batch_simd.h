@@ -0,0 +1,37 @@
+#ifndef BATCH_SIMD_H
+#define BATCH_SIMD_H
+
+#include "board_batch.h"
+
+/* The vector kernels treat each board as one 32-bit lane, X in the low half */
+#if SIZE * SIZE <= 16 && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define BATCH_SIMD
+#include <immintrin.h>
+
+// Lanes are loaded straight from the input, so boards must be 32 bits
+typedef char packed_board_is_32_bits[sizeof(PackedBoard) == 4 ? 1 : -1];
+#endif
+
+typedef enum {
+  BATCH_ISA_SCALAR,
+  BATCH_ISA_SSE2,  // Only when the build targets it, as every x86-64 CPU does
+  BATCH_ISA_AVX2,  // Checked at runtime, the kernels are compiled for it
+} BatchIsa;
+
+/**
+ * @brief Get the widest instruction set the batch kernels can use on this
+ * CPU, checked on first use.
+ * @return BatchIsa BATCH_ISA_SCALAR if the board does not fit in a 32-bit
+ * lane or the target is not x86.
+ */
+BatchIsa batch_isa(void);
+
+/**
+ * @brief Get the name of an instruction set.
+ * @param isa The instruction set.
+ * @return const char* "AVX2", "SSE2" or "Scalar".
+ */
+const char* batch_isa_name(BatchIsa isa);
+
+#endif  // BATCH_SIMD_H
@@ -6,23 +6,115 @@
  */
 #include "board.h"
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-static const Cell WIN_PATTERNS[8][3] = {
-    // Rows
-    {{0, 0}, {0, 1}, {0, 2}},
-    {{1, 0}, {1, 1}, {1, 2}},
-    {{2, 0}, {2, 1}, {2, 2}},
-    // Columns
-    {{0, 0}, {1, 0}, {2, 0}},
-    {{0, 1}, {1, 1}, {2, 1}},
-    {{0, 2}, {1, 2}, {2, 2}},
-    // Diagonals
-    {{0, 0}, {1, 1}, {2, 2}},
-    {{0, 2}, {1, 1}, {2, 0}}};
+/* Line and Zobrist tables, generated on first use by build_tables() */
+static Cell LINES[NUM_LINES][WIN_LENGTH];
+static BitMask LINE_MASKS[NUM_LINES];
+// Lines passing through each cell, at most one per direction and offset
+static int CELL_LINES[SIZE * SIZE][4 * WIN_LENGTH];
+static int CELL_LINE_COUNT[SIZE * SIZE];
+// Cell index mapping of each symmetry, SYMMETRIES[t][index] = transformed
+static int SYMMETRIES[NUM_SYMMETRIES][SIZE * SIZE];
+// Index of the transform that undoes each symmetry
+static const int INVERSE_SYMMETRY[NUM_SYMMETRIES] = {0, 3, 2, 1, 4, 5, 6, 7};
+
+// Zobrist keys for an X or O on each cell, and for O being the player to move
+static uint64_t ZOBRIST_CELLS[SIZE * SIZE][2];
+static uint64_t ZOBRIST_O_TO_MOVE;
+static bool tables_built = false;
+
+#define ZOBRIST_SEED 0x1103C0FFEEULL  // Fixed seed so keys are reproducible
+
+// Directions of rows, columns, diagonals and anti-diagonals
+static const Cell LINE_DIRECTIONS[4] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+// Cast before shifting so narrow masks are not sign-extended by promotion
+#define FULL_MASK \
+  ((BitMask)((BitMask)~(BitMask)0 >> (8 * sizeof(BitMask) - SIZE * SIZE)))
+
+/**
+ * @brief Advance a SplitMix64 generator, used to fill the Zobrist table.
+ * @param state Pointer to the generator state.
+ * @return uint64_t The next pseudo-random value.
+ */
+static uint64_t splitmix64(uint64_t* state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Generate every line of WIN_LENGTH cells and index them per cell, and
+ * fill the Zobrist keys.
+ *
+ * Lines are ordered rows, columns, diagonals, then anti-diagonals, which
+ * matches the fixed 3x3 pattern table this replaces.
+ */
+static void build_tables(void) {
+  if (tables_built) return;
+
+  int line = 0;
+  for (int d = 0; d < 4; d++) {
+    Cell dir = LINE_DIRECTIONS[d];
+    for (int row = 0; row < SIZE; row++) {
+      for (int col = 0; col < SIZE; col++) {
+        // Skip starting cells where the line would run off the board
+        int end_row = row + dir.row * (WIN_LENGTH - 1);
+        int end_col = col + dir.col * (WIN_LENGTH - 1);
+        if (end_row >= SIZE || end_col < 0 || end_col >= SIZE) continue;
+
+        LINE_MASKS[line] = 0;
+        for (int k = 0; k < WIN_LENGTH; k++) {
+          Cell cell = {row + dir.row * k, col + dir.col * k};
+          int index = cell.row * SIZE + cell.col;
+          LINES[line][k] = cell;
+          LINE_MASKS[line] |= BB_BIT(index);
+          CELL_LINES[index][CELL_LINE_COUNT[index]++] = line;
+        }
+        line++;
+      }
+    }
+  }
+
+  const int n = SIZE - 1;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      const Cell images[NUM_SYMMETRIES] = {
+          {row, col},     {col, n - row}, {n - row, n - col}, {n - col, row},
+          {row, n - col}, {n - row, col}, {col, row},         {n - col, n - row},
+      };
+      for (int t = 0; t < NUM_SYMMETRIES; t++) {
+        SYMMETRIES[t][row * SIZE + col] = images[t].row * SIZE + images[t].col;
+      }
+    }
+  }
+
+  uint64_t seed = ZOBRIST_SEED;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    ZOBRIST_CELLS[i][0] = splitmix64(&seed);
+    ZOBRIST_CELLS[i][1] = splitmix64(&seed);
+  }
+  ZOBRIST_O_TO_MOVE = splitmix64(&seed);
+  tables_built = true;
+}
+
+/**
+ * @brief Verify the incremental Zobrist key in debug builds.
+ * @param board Pointer to the Board structure.
+ */
+static void check_hash(const Board* board) {
+#ifdef BOARD_DEBUG_HASH
+  assert(board->hash == compute_board_hash(board));
+#else
+  (void)board;
+#endif
+}
 
 /**
  * @brief Check if a specific cell is empty.
@@ -44,6 +136,7 @@ static bool check_cell(const Board* board, const Cell* cell) {
 }
 
 void init_board(Board* board, Player starting_player) {
+  build_tables();
   for (int i = 0; i < SIZE; i++) {
     for (int j = 0; j < SIZE; j++) {
       board->cells[i][j] = EMPTY;
@@ -52,13 +145,66 @@ void init_board(Board* board, Player starting_player) {
   board->current_player = starting_player;
   board->last_move = (Cell){-1, -1};
   board->move_count = 0;
+  memset(board->line_count, 0, sizeof(board->line_count));
+  memset(board->lines_won, 0, sizeof(board->lines_won));
+  board->hash = (starting_player == PLAYER_O) ? ZOBRIST_O_TO_MOVE : 0;
+  check_hash(board);
 }
 
 void copy_board(const Board* src, Board* dest) {
-  memcpy(dest->cells, src->cells, sizeof(src->cells));
-  dest->current_player = src->current_player;
-  dest->last_move = src->last_move;
-  dest->move_count = src->move_count;
+  memcpy(dest, src, sizeof(Board));
+}
+
+uint64_t compute_board_hash(const Board* board) {
+  build_tables();
+  uint64_t hash = (board->current_player == PLAYER_O) ? ZOBRIST_O_TO_MOVE : 0;
+  for (int i = 0; i < SIZE; i++) {
+    for (int j = 0; j < SIZE; j++) {
+      CellState state = board->cells[i][j];
+      if (state != EMPTY) hash ^= ZOBRIST_CELLS[i * SIZE + j][state - X];
+    }
+  }
+  return hash;
+}
+
+/**
+ * @brief Add or remove a mark from the counters of every line through a cell,
+ * and toggle it and the player to move in the Zobrist key.
+ * @param board Pointer to the Board structure.
+ * @param cell Pointer to the cell that changed.
+ * @param state The mark placed on or removed from the cell (X or O).
+ * @param delta +1 when placing the mark, -1 when removing it.
+ */
+static void update_lines(Board* board, const Cell* cell, CellState state,
+                         int delta) {
+  int player = state - X;  // 0 for X, 1 for O
+  int index = cell->row * SIZE + cell->col;
+  board->hash ^= ZOBRIST_CELLS[index][player] ^ ZOBRIST_O_TO_MOVE;
+  for (int i = 0; i < CELL_LINE_COUNT[index]; i++) {
+    unsigned char* count = &board->line_count[CELL_LINES[index][i]][player];
+    if (delta < 0 && *count == WIN_LENGTH) board->lines_won[player]--;
+    *count += delta;
+    if (delta > 0 && *count == WIN_LENGTH) board->lines_won[player]++;
+  }
+}
+
+void sync_board(Board* board) {
+  build_tables();
+  board->last_move = (Cell){-1, -1};
+  board->move_count = 0;
+  memset(board->line_count, 0, sizeof(board->line_count));
+  memset(board->lines_won, 0, sizeof(board->lines_won));
+  for (int i = 0; i < SIZE; i++) {
+    for (int j = 0; j < SIZE; j++) {
+      CellState state = board->cells[i][j];
+      if (state == EMPTY) continue;
+      update_lines(board, &(Cell){i, j}, state, 1);
+      // Mark the slot as unknown so undo_move stops here
+      board->history[board->move_count++] = (Cell){-1, -1};
+    }
+  }
+  // The player to move is unchanged, so rehash instead of toggling per mark
+  board->hash = compute_board_hash(board);
 }
 
 int find_empty_cells(const Board* board, Cell empty_cells[], size_t max_cells) {
@@ -88,63 +234,241 @@ bool make_move(Board* board, const Cell* cell) {
   if (!check_cell(board, cell)) {
     return false;
   }
-  board->cells[cell->row][cell->col] =
-      (board->current_player == PLAYER_X) ? X : O;
-  board->move_count++;
+  CellState state = (board->current_player == PLAYER_X) ? X : O;
+  board->cells[cell->row][cell->col] = state;
+  update_lines(board, cell, state, 1);
+  board->history[board->move_count++] = *cell;
   board->current_player =
       (board->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
   board->last_move = *cell;
+  check_hash(board);
   return true;
 }
 
 bool undo_move(Board* board) {
-  Cell last_move = board->last_move;
+  if (board->move_count == 0) return false;
+  Cell last_move = board->history[board->move_count - 1];
   if (last_move.row == -1 || last_move.col == -1) {
     return false;
   }
+  update_lines(board, &last_move, board->cells[last_move.row][last_move.col],
+               -1);
   board->cells[last_move.row][last_move.col] = EMPTY;
   board->move_count--;
   board->current_player =
       (board->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
-  // Reset last move
-  board->last_move = (Cell){-1, -1};
+  // Step back to the previous move
+  board->last_move = (board->move_count > 0)
+                         ? board->history[board->move_count - 1]
+                         : (Cell){-1, -1};
+  check_hash(board);
   return true;
 }
 
-Winner check_winner(const Board* board, Cell winning_cells[SIZE]) {
-  size_t patterns = sizeof(WIN_PATTERNS) / sizeof(WIN_PATTERNS[0]);
+Winner check_winner(const Board* board, Cell winning_cells[WIN_LENGTH]) {
+  // Counters are indexed 0 for X and 1 for O
+  bool x_won = board->lines_won[0] > 0;
+  bool o_won = board->lines_won[1] > 0;
 
-  for (size_t i = 0; i < patterns; ++i) {
-    const Cell* pattern = WIN_PATTERNS[i];
-    CellState a = board->cells[pattern[0].row][pattern[0].col];
-    CellState b = board->cells[pattern[1].row][pattern[1].col];
-    CellState c = board->cells[pattern[2].row][pattern[2].col];
+  if (!x_won && !o_won) {
+    return (board->move_count < SIZE * SIZE) ? ONGOING : DRAW;
+  }
+  if (!winning_cells && x_won != o_won) return x_won ? WIN_X : WIN_O;
 
-    if (a != EMPTY && a == b && b == c) {
-      if (winning_cells) {
-        winning_cells[0] = pattern[0];
-        winning_cells[1] = pattern[1];
-        winning_cells[2] = pattern[2];
-      }
-      return (a == X) ? WIN_X : WIN_O;
-    }
+  // Locate the first completed line for the caller (or to break a tie)
+  for (int i = 0; i < NUM_LINES; ++i) {
+    bool x_line = board->line_count[i][0] == WIN_LENGTH;
+    bool o_line = board->line_count[i][1] == WIN_LENGTH;
+    if (!x_line && !o_line) continue;
+    if (winning_cells) memcpy(winning_cells, LINES[i], sizeof(LINES[i]));
+    return x_line ? WIN_X : WIN_O;
   }
 
-  int empty_count = find_empty_cells(board, NULL, 0);
-  if (empty_count > 0) {
-    return ONGOING;
+  return ONGOING;
+}
+
+bool is_winning_move(const Board* board, const Cell* cell, Player player) {
+  build_tables();
+  int index = cell->row * SIZE + cell->col;
+  int p = (player == PLAYER_X) ? 0 : 1;
+  // The cell is empty, so a line one mark short has no opponent marks in it
+  for (int i = 0; i < CELL_LINE_COUNT[index]; i++) {
+    if (board->line_count[CELL_LINES[index][i]][p] == WIN_LENGTH - 1) {
+      return true;
+    }
   }
+  return false;
+}
 
-  return DRAW;
+int count_cell_lines(const Cell* cell) {
+  build_tables();
+  return CELL_LINE_COUNT[cell->row * SIZE + cell->col];
 }
 
-Cell random_move(const Board* board) {
+Cell random_move(const Board* board, Rng* rng) {
   Cell empty_cells[SIZE * SIZE];
   int empty_count = find_empty_cells(board, empty_cells, SIZE * SIZE);
   if (empty_count == 0) {
     return (Cell){-1, -1};
   }
 
-  int rand_index = rand() % empty_count;
+  int rand_index = (int)rng_bounded(rng, (uint32_t)empty_count);
   return empty_cells[rand_index];
 }
+
+void board_to_bitboard(const Board* board, BitBoard* bitboard) {
+  bitboard->x = 0;
+  bitboard->o = 0;
+  for (int i = 0; i < SIZE; i++) {
+    for (int j = 0; j < SIZE; j++) {
+      BitMask bit = BB_BIT(i * SIZE + j);
+      if (board->cells[i][j] == X) {
+        bitboard->x |= bit;
+      } else if (board->cells[i][j] == O) {
+        bitboard->o |= bit;
+      }
+    }
+  }
+}
+
+void bitboard_to_board(const BitBoard* bitboard, Player current_player,
+                       Board* board) {
+  init_board(board, current_player);
+  for (int i = 0; i < SIZE; i++) {
+    for (int j = 0; j < SIZE; j++) {
+      BitMask bit = BB_BIT(i * SIZE + j);
+      if (bitboard->x & bit) {
+        board->cells[i][j] = X;
+      } else if (bitboard->o & bit) {
+        board->cells[i][j] = O;
+      }
+    }
+  }
+  sync_board(board);
+}
+
+BitMask bb_empty_mask(const BitBoard* bitboard) {
+  return (BitMask)(~(bitboard->x | bitboard->o) & FULL_MASK);
+}
+
+int bb_find_empty_cells(const BitBoard* bitboard, Cell empty_cells[],
+                        size_t max_cells) {
+  BitMask empty = bb_empty_mask(bitboard);
+  if (empty_cells == NULL) return bb_popcount(empty);
+
+  int count = 0;
+  while (empty && count < (int)max_cells) {
+    int index = bb_lowest_bit(empty);
+    empty_cells[count++] = (Cell){index / SIZE, index % SIZE};
+    empty &= empty - 1;
+  }
+  return count;
+}
+
+Winner bb_check_winner(const BitBoard* bitboard) {
+  build_tables();
+  for (int i = 0; i < NUM_LINES; ++i) {
+    BitMask mask = LINE_MASKS[i];
+    if ((bitboard->x & mask) == mask) return WIN_X;
+    if ((bitboard->o & mask) == mask) return WIN_O;
+  }
+
+  if ((bitboard->x | bitboard->o) != FULL_MASK) return ONGOING;
+  return DRAW;
+}
+
+const BitMask* bb_line_masks(void) {
+  build_tables();
+  return LINE_MASKS;
+}
+
+Cell transform_cell(const Cell* cell, int transform) {
+  build_tables();
+  int index = SYMMETRIES[transform][cell->row * SIZE + cell->col];
+  return (Cell){index / SIZE, index % SIZE};
+}
+
+Cell inverse_transform_cell(const Cell* cell, int transform) {
+  return transform_cell(cell, INVERSE_SYMMETRY[transform]);
+}
+
+void transform_board(const Board* src, int transform, Board* dest) {
+  build_tables();
+  const int* map = SYMMETRIES[transform];
+  bool history_known = true;
+  for (int m = 0; m < src->move_count; m++) {
+    if (src->history[m].row == -1) history_known = false;
+  }
+
+  if (!history_known) {
+    // Without the move order the counters have to be rebuilt from the cells
+    copy_board(src, dest);
+    for (int i = 0; i < SIZE * SIZE; i++) {
+      int to = map[i];
+      dest->cells[to / SIZE][to % SIZE] = src->cells[i / SIZE][i % SIZE];
+    }
+    sync_board(dest);
+    return;
+  }
+
+  // Replay the transformed moves so the history and counters stay usable
+  Player starting_player = src->current_player;
+  if (src->move_count % 2 != 0) {
+    starting_player = (starting_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+  }
+  init_board(dest, starting_player);
+  for (int m = 0; m < src->move_count; m++) {
+    Cell cell = transform_cell(&src->history[m], transform);
+    make_move(dest, &cell);
+  }
+}
+
+int canonical_board(const Board* board, Board* canonical) {
+  build_tables();
+  int best = 0;
+  for (int t = 1; t < NUM_SYMMETRIES; t++) {
+    // Compare transformed boards cell by cell in row-major order; cell j of
+    // transform t holds the original cell that t maps onto j
+    const int* from = SYMMETRIES[INVERSE_SYMMETRY[t]];
+    const int* best_from = SYMMETRIES[INVERSE_SYMMETRY[best]];
+    for (int j = 0; j < SIZE * SIZE; j++) {
+      CellState a = board->cells[from[j] / SIZE][from[j] % SIZE];
+      CellState b = board->cells[best_from[j] / SIZE][best_from[j] % SIZE];
+      if (a != b) {
+        if (a < b) best = t;
+        break;
+      }
+    }
+  }
+  if (canonical) transform_board(board, best, canonical);
+  return best;
+}
+
+int find_unique_moves(const Board* board, Cell unique_cells[],
+                      size_t max_cells) {
+  build_tables();
+  // Collect the symmetries that leave the board unchanged
+  int stabilisers[NUM_SYMMETRIES];
+  int num_stabilisers = 0;
+  for (int t = 0; t < NUM_SYMMETRIES; t++) {
+    bool same = true;
+    for (int i = 0; i < SIZE * SIZE && same; i++) {
+      int to = SYMMETRIES[t][i];
+      same = board->cells[i / SIZE][i % SIZE] ==
+             board->cells[to / SIZE][to % SIZE];
+    }
+    if (same) stabilisers[num_stabilisers++] = t;
+  }
+
+  // Keep an empty cell only if no stabiliser maps it onto an earlier cell
+  int count = 0;
+  for (int i = 0; i < SIZE * SIZE && count < (int)max_cells; i++) {
+    if (board->cells[i / SIZE][i % SIZE] != EMPTY) continue;
+    bool first = true;
+    for (int s = 0; s < num_stabilisers && first; s++) {
+      first = SYMMETRIES[stabilisers[s]][i] >= i;
+    }
+    if (first) unique_cells[count++] = (Cell){i / SIZE, i % SIZE};
+  }
+  return count;
+}
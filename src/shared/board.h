@@ -3,8 +3,33 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
+#include "rng.h"
+
+/* Board dimensions and win length, overridable at build time (see
+ * meson_options.txt) to play k-in-a-row on larger square boards */
+#ifndef SIZE
 #define SIZE 3
+#endif
+#ifndef WIN_LENGTH
+#define WIN_LENGTH SIZE
+#endif
+
+#if SIZE < 1 || SIZE > 8
+#error "SIZE must be between 1 and 8 so that a cell fits in a 64-bit mask"
+#endif
+#if WIN_LENGTH < 1 || WIN_LENGTH > SIZE
+#error "WIN_LENGTH must be between 1 and SIZE"
+#endif
+
+// Rotations and reflections of a square board
+#define NUM_SYMMETRIES 8
+
+// Number of starting positions for a line along one row or column
+#define WIN_SPAN (SIZE - WIN_LENGTH + 1)
+// Rows + columns + diagonals + anti-diagonals
+#define NUM_LINES (2 * SIZE * WIN_SPAN + 2 * WIN_SPAN * WIN_SPAN)
 
 typedef enum { EMPTY, X, O } CellState;
 typedef enum { PLAYER_X = 1, PLAYER_O = 2 } Player;
@@ -20,8 +45,32 @@ typedef struct {
   Player current_player;
   Cell last_move;
   int move_count;
+  // Moves in the order they were made, history[move_count - 1] is the latest
+  Cell history[SIZE * SIZE];
+  // Marks placed by X and O in every line, maintained by make/undo_move
+  unsigned char line_count[NUM_LINES][2];
+  // Number of lines completed by X and O
+  unsigned char lines_won[2];
+  // Zobrist key of the cells and player to move, maintained by make/undo_move
+  uint64_t hash;
 } Board;
 
+/* One bit per cell in row-major order (bit = row * SIZE + col) */
+#if SIZE * SIZE <= 16
+typedef uint16_t BitMask;
+#elif SIZE * SIZE <= 32
+typedef uint32_t BitMask;
+#else
+typedef uint64_t BitMask;
+#endif
+
+#define BB_BIT(index) ((BitMask)1 << (index))
+
+typedef struct {
+  BitMask x;
+  BitMask o;
+} BitBoard;
+
 typedef struct {
   int score_X;
   int score_O;
@@ -42,6 +91,29 @@ void init_board(Board* board, Player starting_player);
  */
 void copy_board(const Board* src, Board* dest);
 
+/**
+ * @brief Recompute the move count and line counters from the cells.
+ *
+ * Only needed after writing to board->cells directly instead of going through
+ * make_move and undo_move. The order of the existing moves cannot be recovered
+ * from the cells, so they can no longer be undone.
+ *
+ * @param board Pointer to the Board structure.
+ */
+void sync_board(Board* board);
+
+/**
+ * @brief Compute the Zobrist key of a board from scratch.
+ *
+ * Boards keep their key up to date incrementally in board->hash, so this is
+ * only needed to verify it. Building with -DBOARD_DEBUG_HASH checks the
+ * incremental key against this after every update.
+ *
+ * @param board Pointer to the Board structure.
+ * @return uint64_t The Zobrist key of the board.
+ */
+uint64_t compute_board_hash(const Board* board);
+
 /**
  * @brief Find all empty cells on the board.
  * @param board Pointer to the Board structure.
@@ -62,6 +134,10 @@ bool make_move(Board* board, const Cell* cell);
 
 /**
  * @brief Undo the last move made on the board.
+ *
+ * Moves are kept on a stack, so this can be called repeatedly to step back to
+ * the start of the game.
+ *
  * @param board Pointer to the Board structure.
  * @return true if the undo was successful, false otherwise.
  */
@@ -69,19 +145,196 @@ bool undo_move(Board* board);
 
 /**
  * @brief Check if there is a winner or if the game is a draw.
+ *
+ * Reads the line counters kept by make_move, so this is O(1) unless the
+ * winning cells are requested.
+ *
  * @param board Pointer to the Board structure.
  * @param winning_cells Output array to store the winning cell positions. Can be
  * NULL if not needed.
  * @return Winner WIN_X if player X wins, WIN_O if player O wins,
  * DRAW if it's a draw, or ONGOING if the game is still ongoing.
  */
-Winner check_winner(const Board* board, Cell winning_cells[SIZE]);
+Winner check_winner(const Board* board, Cell winning_cells[WIN_LENGTH]);
+
+/**
+ * @brief Check whether a move would complete a line for a player.
+ *
+ * Reads the line counters, so this only looks at the lines through the cell.
+ *
+ * @param board Pointer to the Board structure.
+ * @param cell Pointer to the Cell structure of an empty cell.
+ * @param player The player who would place the mark.
+ * @return true if placing the mark wins the game for the player.
+ */
+bool is_winning_move(const Board* board, const Cell* cell, Player player);
+
+/**
+ * @brief Count the lines of WIN_LENGTH cells passing through a cell.
+ *
+ * Cells on more lines take part in more threats, e.g. on a 3x3 board the
+ * center is on 4 lines, the corners on 3 and the edges on 2.
+ *
+ * @param cell Pointer to the Cell structure.
+ * @return int The number of lines through the cell.
+ */
+int count_cell_lines(const Cell* cell);
 
 /**
  * @brief Select a random valid move from the available empty cells.
  * @param board Pointer to the Board structure.
+ * @param rng Pointer to the random number generator to draw from.
  * @return Cell The selected random move.
  */
-Cell random_move(const Board* board);
+Cell random_move(const Board* board, Rng* rng);
+
+/**
+ * @brief Map a cell through one of the board symmetries.
+ *
+ * Transform 0 is the identity, 1-3 rotate by 90, 180 and 270 degrees
+ * clockwise, and 4-7 mirror across the vertical axis, horizontal axis, main
+ * diagonal and anti-diagonal.
+ *
+ * @param cell Pointer to the Cell structure to map.
+ * @param transform Index of the symmetry, 0 to NUM_SYMMETRIES - 1.
+ * @return Cell The transformed cell.
+ */
+Cell transform_cell(const Cell* cell, int transform);
+
+/**
+ * @brief Map a cell back through the inverse of a board symmetry.
+ * @param cell Pointer to the Cell structure to map.
+ * @param transform Index of the symmetry that was applied.
+ * @return Cell The cell before the transform was applied.
+ */
+Cell inverse_transform_cell(const Cell* cell, int transform);
+
+/**
+ * @brief Apply a symmetry to a whole board, including its move history.
+ * @param src Pointer to the source Board structure.
+ * @param transform Index of the symmetry to apply.
+ * @param dest Pointer to the destination Board structure.
+ */
+void transform_board(const Board* src, int transform, Board* dest);
+
+/**
+ * @brief Find the canonical form of a board among its symmetries.
+ *
+ * The canonical form is the transformed board with the lowest cells in
+ * row-major order, so every board in a symmetry class maps to the same one.
+ * Moves found on the canonical board are mapped back to the original with
+ * inverse_transform_cell.
+ *
+ * @param board Pointer to the Board structure.
+ * @param canonical Pointer to store the canonical board. Can be NULL to just
+ * find the transform.
+ * @return int Index of the symmetry that maps board to its canonical form.
+ */
+int canonical_board(const Board* board, Board* canonical);
+
+/**
+ * @brief Find the empty cells that are distinct under the symmetries the board
+ * itself has.
+ *
+ * For example, all four corners lead to equivalent positions on an empty board,
+ * so only the first one is returned.
+ *
+ * @param board Pointer to the Board structure.
+ * @param unique_cells Output array to store the distinct empty cells.
+ * @param max_cells Maximum number of cells the array can hold.
+ * @return int The number of distinct empty cells found.
+ */
+int find_unique_moves(const Board* board, Cell unique_cells[],
+                      size_t max_cells);
+
+/**
+ * @brief Convert a board to its bitboard representation.
+ * @param board Pointer to the source Board structure.
+ * @param bitboard Pointer to the destination BitBoard structure.
+ */
+void board_to_bitboard(const Board* board, BitBoard* bitboard);
+
+/**
+ * @brief Convert a bitboard back to a full board.
+ *
+ * The move history is not stored in a bitboard, so the last move is left
+ * unset.
+ *
+ * @param bitboard Pointer to the source BitBoard structure.
+ * @param current_player The player whose turn it is.
+ * @param board Pointer to the destination Board structure.
+ */
+void bitboard_to_board(const BitBoard* bitboard, Player current_player,
+                       Board* board);
+
+/**
+ * @brief Get the mask of empty cells on a bitboard.
+ * @param bitboard Pointer to the BitBoard structure.
+ * @return BitMask with a bit set for every empty cell.
+ */
+BitMask bb_empty_mask(const BitBoard* bitboard);
+
+/**
+ * @brief Find all empty cells on a bitboard.
+ * @param bitboard Pointer to the BitBoard structure.
+ * @param empty_cells Output array to store empty cell positions. Can be NULL to
+ * just count empty cells.
+ * @param max_cells Maximum number of cells the array can hold.
+ * @return int The number of empty cells found.
+ */
+int bb_find_empty_cells(const BitBoard* bitboard, Cell empty_cells[],
+                        size_t max_cells);
+
+/**
+ * @brief Check if there is a winner or if the game is a draw on a bitboard.
+ * @param bitboard Pointer to the BitBoard structure.
+ * @return Winner WIN_X if player X wins, WIN_O if player O wins,
+ * DRAW if it's a draw, or ONGOING if the game is still ongoing.
+ */
+Winner bb_check_winner(const BitBoard* bitboard);
+
+/**
+ * @brief Get the bit mask of every line of WIN_LENGTH cells.
+ *
+ * Lines are ordered rows, columns, diagonals, then anti-diagonals.
+ *
+ * @return const BitMask* Array of NUM_LINES masks.
+ */
+const BitMask* bb_line_masks(void);
+
+/**
+ * @brief Count the number of set bits in a mask.
+ * @param mask The mask to count.
+ * @return int Number of set bits.
+ */
+static inline int bb_popcount(BitMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (sizeof(BitMask) > sizeof(unsigned int)) ? __builtin_popcountll(mask)
+                                                  : __builtin_popcount(mask);
+#else
+  int count = 0;
+  for (; mask; mask &= mask - 1) count++;
+  return count;
+#endif
+}
+
+/**
+ * @brief Get the index of the lowest set bit in a mask.
+ * @param mask The mask to scan, must be non-zero.
+ * @return int Index of the lowest set bit.
+ */
+static inline int bb_lowest_bit(BitMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (sizeof(BitMask) > sizeof(unsigned int)) ? __builtin_ctzll(mask)
+                                                  : __builtin_ctz(mask);
+#else
+  int index = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
 
 #endif  // BOARD_H
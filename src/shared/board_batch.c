@@ -0,0 +1,191 @@
+/**
+ * @file board_batch.c
+ * @brief Batched win and draw detection over arrays of packed boards.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "board_batch.h"
+
+#include <stdint.h>
+
+#include "batch_simd.h"
+
+#ifdef BATCH_SIMD
+// Lanes are stored straight into the output, so results must be 32 bits
+typedef char winner_is_32_bits[sizeof(Winner) == 4 ? 1 : -1];
+#endif
+
+typedef size_t (*BatchKernel)(const PackedBoard* boards, size_t n,
+                              Winner* out);
+
+/**
+ * @brief Check the outcome of a single packed board.
+ * @param board Pointer to the board to check.
+ * @param lines Array of NUM_LINES line masks.
+ * @param full Mask with every cell set.
+ * @return Winner The outcome of the board.
+ */
+static Winner packed_winner(const PackedBoard* board, const BitMask* lines,
+                            BitMask full) {
+  bool x_won = false;
+  bool o_won = false;
+  for (int i = 0; i < NUM_LINES; i++) {
+    x_won |= (board->x & lines[i]) == lines[i];
+    o_won |= (board->o & lines[i]) == lines[i];
+  }
+
+  if (x_won) return WIN_X;
+  if (o_won) return WIN_O;
+  if ((board->x | board->o) == full) return DRAW;
+  return ONGOING;
+}
+
+/**
+ * @brief Get the mask with every cell of the board set.
+ * @return BitMask The full board mask.
+ */
+static BitMask full_mask(void) {
+  const BitBoard empty = {0, 0};
+  return bb_empty_mask(&empty);
+}
+
+/**
+ * @brief Scalar kernel, also used for the boards left over by the vector
+ * kernels.
+ * @param boards Array of boards to check.
+ * @param n Number of boards in the array.
+ * @param out Output array of results.
+ * @return size_t Number of boards checked, always n.
+ */
+static size_t batch_scalar(const PackedBoard* boards, size_t n, Winner* out) {
+  const BitMask* lines = bb_line_masks();
+  const BitMask full = full_mask();
+  for (size_t i = 0; i < n; i++) out[i] = packed_winner(&boards[i], lines, full);
+  return n;
+}
+
+#ifdef BATCH_SIMD
+#ifdef __SSE2__
+/**
+ * @brief SSE2 kernel, checks four boards per iteration.
+ * @param boards Array of boards to check.
+ * @param n Number of boards in the array.
+ * @param out Output array of results.
+ * @return size_t Number of boards checked, a multiple of four.
+ */
+static size_t batch_sse2(const PackedBoard* boards, size_t n, Winner* out) {
+  const BitMask* lines = bb_line_masks();
+  // Each line mask repeated in both halves to test X and O in one compare
+  __m128i line_pairs[NUM_LINES];
+  for (int i = 0; i < NUM_LINES; i++) {
+    line_pairs[i] = _mm_set1_epi32((int)((uint32_t)lines[i] * 0x10001u));
+  }
+  const __m128i low_half = _mm_set1_epi32(0xFFFF);
+  const __m128i full = _mm_set1_epi32(full_mask());
+  const __m128i win_x = _mm_set1_epi32(WIN_X);
+  const __m128i win_o = _mm_set1_epi32(WIN_O);
+  const __m128i draw = _mm_set1_epi32(DRAW);
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i packed = _mm_loadu_si128((const __m128i*)&boards[i]);
+    // 16-bit halves become all ones when that player completed any line
+    __m128i won = _mm_setzero_si128();
+    for (int j = 0; j < NUM_LINES; j++) {
+      __m128i hit = _mm_and_si128(packed, line_pairs[j]);
+      won = _mm_or_si128(won, _mm_cmpeq_epi16(hit, line_pairs[j]));
+    }
+    __m128i x_won = _mm_srai_epi32(_mm_slli_epi32(won, 16), 31);
+    __m128i o_won = _mm_srai_epi32(won, 31);
+    __m128i occupied =
+        _mm_and_si128(_mm_or_si128(packed, _mm_srli_epi32(packed, 16)), low_half);
+    __m128i is_full = _mm_cmpeq_epi32(occupied, full);
+
+    // Select X win over O win over draw over ongoing
+    __m128i result = _mm_and_si128(is_full, draw);
+    result = _mm_or_si128(_mm_and_si128(o_won, win_o),
+                          _mm_andnot_si128(o_won, result));
+    result = _mm_or_si128(_mm_and_si128(x_won, win_x),
+                          _mm_andnot_si128(x_won, result));
+    _mm_storeu_si128((__m128i*)&out[i], result);
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief AVX2 kernel, checks eight boards per iteration.
+ *
+ * Compiled for AVX2 regardless of the build flags and only called after the
+ * CPU has been checked for support.
+ *
+ * @param boards Array of boards to check.
+ * @param n Number of boards in the array.
+ * @param out Output array of results.
+ * @return size_t Number of boards checked, a multiple of eight.
+ */
+__attribute__((target("avx2"))) static size_t batch_avx2(
+    const PackedBoard* boards, size_t n, Winner* out) {
+  const BitMask* lines = bb_line_masks();
+  __m256i line_pairs[NUM_LINES];
+  for (int i = 0; i < NUM_LINES; i++) {
+    line_pairs[i] = _mm256_set1_epi32((int)((uint32_t)lines[i] * 0x10001u));
+  }
+  const __m256i low_half = _mm256_set1_epi32(0xFFFF);
+  const __m256i full = _mm256_set1_epi32(full_mask());
+  const __m256i win_x = _mm256_set1_epi32(WIN_X);
+  const __m256i win_o = _mm256_set1_epi32(WIN_O);
+  const __m256i draw = _mm256_set1_epi32(DRAW);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i packed = _mm256_loadu_si256((const __m256i*)&boards[i]);
+    __m256i won = _mm256_setzero_si256();
+    for (int j = 0; j < NUM_LINES; j++) {
+      __m256i hit = _mm256_and_si256(packed, line_pairs[j]);
+      won = _mm256_or_si256(won, _mm256_cmpeq_epi16(hit, line_pairs[j]));
+    }
+    __m256i x_won = _mm256_srai_epi32(_mm256_slli_epi32(won, 16), 31);
+    __m256i o_won = _mm256_srai_epi32(won, 31);
+    __m256i occupied = _mm256_and_si256(
+        _mm256_or_si256(packed, _mm256_srli_epi32(packed, 16)), low_half);
+    __m256i is_full = _mm256_cmpeq_epi32(occupied, full);
+
+    __m256i result = _mm256_and_si256(is_full, draw);
+    result = _mm256_blendv_epi8(result, win_o, o_won);
+    result = _mm256_blendv_epi8(result, win_x, x_won);
+    _mm256_storeu_si256((__m256i*)&out[i], result);
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief Get the kernel of the widest instruction set the CPU supports.
+ * @return BatchKernel The kernel.
+ */
+static BatchKernel select_kernel(void) {
+  switch (batch_isa()) {
+#ifdef BATCH_SIMD
+    case BATCH_ISA_AVX2:
+      return batch_avx2;
+#ifdef __SSE2__
+    case BATCH_ISA_SSE2:
+      return batch_sse2;
+#endif
+#endif
+    default:
+      return batch_scalar;
+  }
+}
+
+void check_winner_batch(const PackedBoard* boards, size_t n, Winner* out) {
+  if (!boards || !out) return;
+
+  size_t done = select_kernel()(boards, n, out);
+  batch_scalar(boards + done, n - done, out + done);
+}
+
+const char* check_winner_batch_kernel(void) {
+  return batch_isa_name(batch_isa());
+}
@@ -0,0 +1,32 @@
+#ifndef BOARD_BATCH_H
+#define BOARD_BATCH_H
+
+#include <stddef.h>
+
+#include "board.h"
+
+/* Boards are packed as bitboards, one word per board when SIZE * SIZE <= 16
+ * with the X marks in the low half and the O marks in the high half */
+typedef BitBoard PackedBoard;
+
+/**
+ * @brief Check the outcome of many boards at once.
+ *
+ * Uses AVX2 or SSE2 to test every line of several boards per instruction when
+ * the CPU supports it and the board fits in 16 bits per player, and falls back
+ * to a scalar loop otherwise. If both players have a line, which cannot happen
+ * in a legal game, WIN_X is reported.
+ *
+ * @param boards Array of boards to check.
+ * @param n Number of boards in the array.
+ * @param out Output array of n results, WIN_X, WIN_O, DRAW or ONGOING.
+ */
+void check_winner_batch(const PackedBoard* boards, size_t n, Winner* out);
+
+/**
+ * @brief Get the name of the kernel check_winner_batch runs on this CPU.
+ * @return const char* "AVX2", "SSE2" or "Scalar".
+ */
+const char* check_winner_batch_kernel(void);
+
+#endif  // BOARD_BATCH_H
@@ -0,0 +1,97 @@
+/**
+ * @file hybrid.c
+ * @brief Depth-limited minimax with alpha-beta pruning that scores its leaves
+ * with the Naive Bayes model.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+#include "hybrid.h"
+
+/* State shared by every node of one search */
+typedef struct {
+  Player ai_player;
+  int depth;  // Plies to search before scoring a leaf
+  const NaiveBayesModel* model;  // NULL to score leaves as draws
+} HybridSearch;
+
+/**
+ * @brief Score a position still in play at the depth limit.
+ * @param board Pointer to the Board structure.
+ * @param search Pointer to the HybridSearch structure.
+ * @return double Score from -HYBRID_LEAF_WEIGHT to HYBRID_LEAF_WEIGHT.
+ */
+static double leaf_score(const Board* board, const HybridSearch* search) {
+  if (!search->model) return 0.0;
+  double p = nb_win_probability(board, search->ai_player, search->model);
+  return HYBRID_LEAF_WEIGHT * (2.0 * p - 1.0);
+}
+
+/**
+ * @brief Minimax with alpha-beta pruning down to the depth limit.
+ * @param board Pointer to the Board structure, restored before returning.
+ * @param search Pointer to the HybridSearch structure.
+ * @param is_max Whether the AI is to move.
+ * @param alpha Alpha value for pruning.
+ * @param beta Beta value for pruning.
+ * @param ply Plies played since the root, 1 for the root moves.
+ * @return double The score of the position for the AI player.
+ */
+static double hybrid(Board* board, const HybridSearch* search, bool is_max,
+                     double alpha, double beta, int ply) {
+  // Evaluate terminal states
+  Winner result = check_winner(board, NULL);
+  if (result == DRAW) return 0.0;
+  if (result == WIN_X || result == WIN_O) {
+    double score = SIZE * SIZE - ply;
+    Player winner = (result == WIN_X) ? PLAYER_X : PLAYER_O;
+    return (search->ai_player == winner) ? score : -score;
+  }
+  if (ply >= search->depth) return leaf_score(board, search);
+
+  Cell moves[SIZE * SIZE];
+  int num_moves = find_empty_cells(board, moves, SIZE * SIZE);
+  double best_score = is_max ? -SIZE * SIZE : SIZE * SIZE;
+  for (int m = 0; m < num_moves; m++) {
+    make_move(board, &moves[m]);
+    double score = hybrid(board, search, !is_max, alpha, beta, ply + 1);
+    undo_move(board);
+    if (is_max) {
+      if (score > best_score) best_score = score;
+      if (best_score > alpha) alpha = best_score;
+    } else {
+      if (score < best_score) best_score = score;
+      if (best_score < beta) beta = best_score;
+    }
+    if (beta <= alpha) break;
+  }
+  return best_score;
+}
+
+Cell hybrid_find_move(const Board* board, int depth,
+                      const NaiveBayesModel* model) {
+  Cell best_move = {-1, -1};
+  if (check_winner(board, NULL) != ONGOING) return best_move;
+
+  HybridSearch search = {
+      .ai_player = board->current_player,
+      .depth = (depth > 0) ? depth : HYBRID_DEFAULT_DEPTH,
+      .model = model,
+  };
+  Board copy;
+  copy_board(board, &copy);
+
+  Cell moves[SIZE * SIZE];
+  int num_moves = find_empty_cells(&copy, moves, SIZE * SIZE);
+  double best_score = -SIZE * SIZE - 1.0;
+  // Evaluate moves, keeping the first of equally scored ones
+  for (int m = 0; m < num_moves; m++) {
+    make_move(&copy, &moves[m]);
+    double score = hybrid(&copy, &search, false, best_score, SIZE * SIZE, 1);
+    undo_move(&copy);
+    if (score > best_score) {
+      best_score = score;
+      best_move = moves[m];
+    }
+  }
+  return best_move;
+}
@@ -0,0 +1,36 @@
+#ifndef HYBRID_H
+#define HYBRID_H
+
+#include "board.h"
+#include "naive_bayes.h"
+
+#define HYBRID_DEFAULT_DEPTH 2  // Plies searched when no depth is given
+// Largest leaf score, below the smallest win so a proven result always beats
+// an estimate
+#define HYBRID_LEAF_WEIGHT 0.5
+
+/**
+ * @brief Selects a move using depth-limited minimax whose unresolved leaves
+ * are scored by the Naive Bayes model.
+ *
+ * Positions still ongoing after depth plies score the model's win probability
+ * for the player to move at the root, scaled from [0, 1] to
+ * [-HYBRID_LEAF_WEIGHT, HYBRID_LEAF_WEIGHT]. Finished games score as in
+ * minimax, so a shallow search plays known wins and blocks and leaves the
+ * rest to the model instead of calling every unresolved line a draw.
+ *
+ * Only the benchmark uses it. On 3x3 it finds about 83% of optimal moves at
+ * depth 1, close to the medium AI's Naive Bayes alone, and 96% at depth 2,
+ * stronger than the hard AI, so it would not fill a difficulty of the GUI.
+ *
+ * @param board Pointer to the Board structure.
+ * @param depth Plies to search, counting the move itself, 0 for
+ * HYBRID_DEFAULT_DEPTH.
+ * @param model Pointer to the Naive Bayes Model, or NULL to score the leaves
+ * as draws like a plain depth-limited minimax.
+ * @return Cell The selected move, or {-1, -1} if the game is over.
+ */
+Cell hybrid_find_move(const Board* board, int depth,
+                      const NaiveBayesModel* model);
+
+#endif  // HYBRID_H
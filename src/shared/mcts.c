@@ -0,0 +1,240 @@
+/**
+ * @file mcts.c
+ * @brief Monte Carlo Tree Search with UCT selection and random playouts, on
+ * nodes taken from a pre-sized arena.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "mcts.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "timer.h"
+
+// Playouts between checks of the deadline
+#define DEADLINE_CHECK_INTERVAL 16
+
+int mcts_arena_init(MctsArena* arena, int capacity) {
+  if (!arena || capacity < 1) return -1;
+  arena->nodes = malloc((size_t)capacity * sizeof(MctsNode));
+  if (!arena->nodes) {
+    fprintf(stderr, "Error: Failed to allocate MCTS node arena\n");
+    return -1;
+  }
+  arena->capacity = capacity;
+  arena->count = 0;
+  return 0;
+}
+
+void mcts_arena_free(MctsArena* arena) {
+  if (!arena) return;
+  free(arena->nodes);
+  arena->nodes = NULL;
+  arena->capacity = 0;
+  arena->count = 0;
+}
+
+/**
+ * @brief Get the cell of a move index.
+ * @param move Cell index (row * SIZE + col).
+ * @return Cell The cell.
+ */
+static Cell move_cell(int move) { return (Cell){move / SIZE, move % SIZE}; }
+
+/**
+ * @brief Take a node from the arena and link it under its parent.
+ * @param arena Pointer to the MctsArena structure, must not be full.
+ * @param parent Arena index of the parent, -1 for the root.
+ * @param move Cell index of the move that reached the position, -1 for the
+ * root.
+ * @param player The player who played the move.
+ * @param board Pointer to the Board structure in the position of the node.
+ * @return int Arena index of the new node.
+ */
+static int new_node(MctsArena* arena, int parent, int move, Player player,
+                    const Board* board) {
+  int index = arena->count++;
+  MctsNode* node = &arena->nodes[index];
+  node->parent = parent;
+  node->first_child = -1;
+  node->next_sibling = -1;
+  node->move = move;
+  node->player = player;
+  node->terminal = check_winner(board, NULL) != ONGOING;
+  node->untried = 0;
+  node->visits = 0;
+  node->reward = 0.0;
+  if (!node->terminal) {
+    BitBoard bitboard;
+    board_to_bitboard(board, &bitboard);
+    node->untried = bb_empty_mask(&bitboard);
+  }
+  if (parent >= 0) {
+    node->next_sibling = arena->nodes[parent].first_child;
+    arena->nodes[parent].first_child = index;
+  }
+  return index;
+}
+
+/**
+ * @brief Pick the child with the highest upper confidence bound (UCT).
+ * @param arena Pointer to the MctsArena structure.
+ * @param parent Arena index of a node with at least one child.
+ * @return int Arena index of the selected child.
+ */
+static int select_child(const MctsArena* arena, int parent) {
+  const MctsNode* nodes = arena->nodes;
+  double log_visits = log((double)nodes[parent].visits);
+  int best = -1;
+  double best_value = -1.0;
+  // Every child had a playout when it was expanded, so visits is never 0
+  for (int c = nodes[parent].first_child; c >= 0; c = nodes[c].next_sibling) {
+    double visits = (double)nodes[c].visits;
+    double value = nodes[c].reward / visits +
+                   MCTS_EXPLORATION * sqrt(log_visits / visits);
+    if (value > best_value) {
+      best_value = value;
+      best = c;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Score the outcome of a playout for a player.
+ * @param result Outcome of the playout.
+ * @param player The player to score for.
+ * @return double 1 for a win, 0.5 for a draw, 0 for a loss.
+ */
+static double playout_reward(Winner result, Player player) {
+  if (result == DRAW) return 0.5;
+  Player winner = (result == WIN_X) ? PLAYER_X : PLAYER_O;
+  return (winner == player) ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Run one playout: select, expand, simulate and backpropagate.
+ * @param board Pointer to the Board structure in the root position, played on
+ * and left in the position the playout ended in.
+ * @param arena Pointer to the MctsArena structure holding the tree.
+ * @param rng Pointer to the random number generator.
+ */
+static void playout(Board* board, MctsArena* arena, Rng* rng) {
+  MctsNode* nodes = arena->nodes;
+  int node = 0;
+
+  // Selection: descend while every move of the node has a child
+  while (!nodes[node].terminal && nodes[node].untried == 0 &&
+         nodes[node].first_child >= 0) {
+    node = select_child(arena, node);
+    Cell cell = move_cell(nodes[node].move);
+    make_move(board, &cell);
+  }
+
+  // Expansion: add one random untried move, unless the arena is full
+  if (nodes[node].untried && arena->count < arena->capacity) {
+    BitMask untried = nodes[node].untried;
+    int skip = (int)rng_bounded(rng, (uint32_t)bb_popcount(untried));
+    for (; skip > 0; skip--) untried &= untried - 1;
+    int move = bb_lowest_bit(untried);
+    nodes[node].untried &= (BitMask)~BB_BIT(move);
+    Player player = board->current_player;
+    Cell cell = move_cell(move);
+    make_move(board, &cell);
+    node = new_node(arena, node, move, player, board);
+  }
+
+  // Simulation: random moves until the game is over
+  Winner result = check_winner(board, NULL);
+  while (result == ONGOING) {
+    Cell cell = random_move(board, rng);
+    make_move(board, &cell);
+    result = check_winner(board, NULL);
+  }
+
+  // Backpropagation: every node scores the result for the player who moved
+  for (; node >= 0; node = nodes[node].parent) {
+    nodes[node].visits++;
+    nodes[node].reward += playout_reward(result, nodes[node].player);
+  }
+}
+
+int mcts_start(MctsSearch* search, const Board* board,
+               const MctsOptions* options) {
+  if (!search || !board || !options || !options->rng || !options->arena ||
+      !options->arena->nodes) {
+    return -1;
+  }
+  if (check_winner(board, NULL) != ONGOING) return -1;
+
+  search->playouts = options->playouts;
+  if (search->playouts == 0 && options->time_limit_ms <= 0) {
+    search->playouts = MCTS_DEFAULT_PLAYOUTS;
+  }
+  search->deadline_ms = 0.0;
+  if (options->time_limit_ms > 0) {
+    search->deadline_ms = timer_now_ms() + options->time_limit_ms;
+  }
+  search->rng = options->rng;
+  search->arena = options->arena;
+  search->played = 0;
+  search->done = false;
+
+  copy_board(board, &search->board);
+  search->root_move_count = board->move_count;
+  search->arena->count = 0;
+  Player last_player =
+      (board->current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+  new_node(search->arena, -1, -1, last_player, &search->board);
+  return 0;
+}
+
+bool mcts_step(MctsSearch* search, unsigned long max_playouts, double max_ms) {
+  if (search->done) return true;
+  double slice_end_ms = (max_ms > 0) ? timer_now_ms() + max_ms : 0.0;
+
+  for (unsigned long n = 0; max_playouts == 0 || n < max_playouts; n++) {
+    if (search->playouts > 0 && search->played >= search->playouts) {
+      search->done = true;
+      return true;
+    }
+    // Check the clock every few playouts. The deadline is also checked
+    // before the first playout, so slices shorter than the interval still
+    // reach it, while the slice's own time runs for at least one playout
+    if (n % DEADLINE_CHECK_INTERVAL == 0 &&
+        (search->deadline_ms > 0 || slice_end_ms > 0)) {
+      double now = timer_now_ms();
+      if (search->deadline_ms > 0 && now >= search->deadline_ms) {
+        search->done = true;
+        return true;
+      }
+      if (n > 0 && slice_end_ms > 0 && now >= slice_end_ms) return false;
+    }
+    playout(&search->board, search->arena, search->rng);
+    while (search->board.move_count > search->root_move_count) {
+      undo_move(&search->board);
+    }
+    search->played++;
+  }
+  return false;
+}
+
+Cell mcts_result(const MctsSearch* search) {
+  // The most visited move is the most reliable, its value is the best sampled
+  const MctsNode* nodes = search->arena->nodes;
+  int best = -1;
+  for (int c = nodes[0].first_child; c >= 0; c = nodes[c].next_sibling) {
+    if (best < 0 || nodes[c].visits > nodes[best].visits) best = c;
+  }
+  if (best < 0) return random_move(&search->board, search->rng);
+  return move_cell(nodes[best].move);
+}
+
+Cell mcts_find_move(const Board* board, const MctsOptions* options) {
+  MctsSearch search;
+  if (mcts_start(&search, board, options) != 0) return (Cell){-1, -1};
+  mcts_step(&search, 0, 0);
+  return mcts_result(&search);
+}
@@ -0,0 +1,122 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdbool.h>
+
+#include "board.h"
+#include "rng.h"
+
+#define MCTS_DEFAULT_PLAYOUTS 1000  // Playouts when no budget is given
+#define MCTS_EXPLORATION 1.41421356  // UCT exploration constant, sqrt(2)
+
+/* A position in the search tree, reached by playing move from its parent */
+typedef struct {
+  int parent;        // Arena index of the parent, -1 for the root
+  int first_child;   // Arena index of the latest expanded child, -1 if none
+  int next_sibling;  // Arena index of the next child of the parent, -1 if none
+  int move;          // Cell index (row * SIZE + col) of the move played
+  Player player;     // The player who played the move
+  bool terminal;     // The game is over in this position
+  BitMask untried;   // Moves not expanded into children yet
+  unsigned long visits;
+  double reward;  // Sum of playout results for player, 1 a win, 0.5 a draw
+} MctsNode;
+
+/* Pre-sized node storage, allocated once and reused by every search */
+typedef struct {
+  MctsNode* nodes;
+  int capacity;
+  int count;  // Nodes in use by the current search
+} MctsArena;
+
+typedef struct {
+  // Used for expansion order and playouts, must not be NULL
+  Rng* rng;
+  // Node storage, must not be NULL. Once full, the tree stops growing and
+  // playouts continue from its leaves
+  MctsArena* arena;
+  // Stop after this many playouts, 0 for no limit
+  unsigned long playouts;
+  // Stop after this many milliseconds, 0 for no limit. With neither limit,
+  // MCTS_DEFAULT_PLAYOUTS are played
+  double time_limit_ms;
+} MctsOptions;
+
+/* A search that runs a slice at a time, see mcts_start() */
+typedef struct {
+  Board board;  // Copy of the position, played on and rewound by playouts
+  int root_move_count;
+  Rng* rng;
+  MctsArena* arena;
+  unsigned long playouts;  // Playouts to stop after, 0 for no limit
+  unsigned long played;
+  double deadline_ms;  // 0 for no deadline
+  bool done;
+} MctsSearch;
+
+/**
+ * @brief Allocate the node storage of MCTS searches.
+ * @param arena Pointer to the MctsArena structure to initialise.
+ * @param capacity Number of nodes, one more than the playout budget is enough
+ * for the tree to grow by a node every playout.
+ * @return 0 on success, -1 on invalid parameters or allocation failure.
+ */
+int mcts_arena_init(MctsArena* arena, int capacity);
+
+/**
+ * @brief Free the node storage of MCTS searches.
+ * @param arena Pointer to the MctsArena structure.
+ */
+void mcts_arena_free(MctsArena* arena);
+
+/**
+ * @brief Start a search, to be run by mcts_step().
+ *
+ * The search owns the arena until it is finished, and the time limit counts
+ * from this call.
+ *
+ * @param search Pointer to the MctsSearch structure to initialise.
+ * @param board Pointer to the Board structure, copied into the search.
+ * @param options Pointer to the MctsOptions structure.
+ * @return 0 on success, -1 on invalid options or if the game is over.
+ */
+int mcts_start(MctsSearch* search, const Board* board,
+               const MctsOptions* options);
+
+/**
+ * @brief Run a search for a limited number of playouts or time, then return
+ * so the caller can do other work in between.
+ * @param search Pointer to the MctsSearch structure.
+ * @param max_playouts Playouts to run before returning, 0 for no limit.
+ * @param max_ms Milliseconds to run before returning, 0 for no limit.
+ * @return true once the search has used its budget, false if it must be
+ * stepped again.
+ */
+bool mcts_step(MctsSearch* search, unsigned long max_playouts, double max_ms);
+
+/**
+ * @brief Get the most visited root move of a search.
+ *
+ * Can be called before the search is finished to get the best move so far.
+ *
+ * @param search Pointer to the MctsSearch structure.
+ * @return Cell The selected move.
+ */
+Cell mcts_result(const MctsSearch* search);
+
+/**
+ * @brief Selects a move for the player to move using Monte Carlo Tree Search.
+ *
+ * Each playout walks down the tree by UCT, expands one untried move, plays
+ * random moves to the end of the game and adds the result to every node on
+ * the way. The most visited root move is returned, so the engine can be
+ * stopped after any number of playouts and gets stronger with more.
+ *
+ * @param board Pointer to the Board structure.
+ * @param options Pointer to the MctsOptions structure.
+ * @return Cell The selected move, or {-1, -1} if there is none or the options
+ * are invalid.
+ */
+Cell mcts_find_move(const Board* board, const MctsOptions* options);
+
+#endif  // MCTS_H
@@ -8,14 +8,560 @@
 #include "minimax.h"
 
 #include <limits.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "timer.h"
+
+// Nodes searched between checks of the deadline
+#define DEADLINE_CHECK_INTERVAL 256
+// Half width of the window around the previous iteration's root score
+#define ASPIRATION_WINDOW 2
+// Root key of a search that has not scored any move yet, see root_key()
+#define ROOT_NONE -1LL
+// Nodes searched fewer plies deep are over too soon to share between threads
+#define SPLIT_MIN_DRAFT 5
+// A thread owns at most one split point per ply
+#define MAX_SPLIT_POINTS (MAX_SEARCH_THREADS * SIZE * SIZE)
+
+/* Search counters, compiled out unless built with -DSEARCH_STATS */
+#ifdef SEARCH_STATS
+#define STATS_ADD(state, field) ((state)->stats.field++)
+#define STATS_DEPTH(state, depth)                                   \
+  ((state)->stats.max_depth = ((depth) > (state)->stats.max_depth) \
+                                  ? (depth)                        \
+                                  : (state)->stats.max_depth)
+#else
+#define STATS_ADD(state, field) ((void)0)
+#define STATS_DEPTH(state, depth) ((void)0)
+#endif
+
+/* A node whose younger moves are shared between threads (Young Brothers
+ * Wait). Its owner publishes it once the eldest move has set a bound, and
+ * every field but the board is guarded by the lock of its SplitPool */
+typedef struct SplitPoint {
+  struct SplitPoint* parent;  // Split point the owner works under, or NULL
+  Board board;                // Position of the node, not changed once shared
+  Cell moves[SIZE * SIZE];
+  int num_moves;
+  int next_move;  // Index of the next move to hand out
+  int busy;       // Moves handed out whose search has not finished
+  bool is_max;
+  int depth;
+  int alpha;
+  int beta;
+  int best_score;
+  int best_move;
+  int cutoff_move;  // Index of the move that caused a cutoff, -1 if none
+  // Set on a cutoff, also read without the lock by the threads below it
+  int cancelled;
+} SplitPoint;
+
+/* Root moves handed out to the threads of a search */
+typedef struct {
+  const Cell* cells;
+  int num_moves;
+  int next_move;   // Index of the next root move to take
+  int active;      // Root moves taken whose search has not finished
+  long long best;  // Root key of the best move so far, or ROOT_NONE
+  int stop;        // Set once any thread hits a limit
+} RootQueue;
+
+/* Work shared by the threads of a parallel search */
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;  // Broadcast whenever work is added or finished
+  RootQueue* queue;
+  SplitPoint* points[MAX_SPLIT_POINTS];
+  int num_points;
+  int idle;  // Threads waiting for work, also read without the lock
+} SplitPool;
+
+/* State shared by every node of one search */
+typedef struct {
+  Player ai_player;
+  // Nodes this deep score 0 without being evaluated, INT_MAX for no limit
+  int max_depth;
+  TranspositionTable* tt;
+  double deadline_ms;  // 0 for no deadline
+  unsigned long node_budget;  // 0 for no budget
+  unsigned long nodes;
+  bool aborted;  // Set once a limit is hit, the search result is invalid
+  // Shared with the other threads of a parallel search, NULL otherwise
+  long long* shared_best;  // Root key of the best move so far
+  int* stop;                       // Set by the first thread to hit a limit
+  SplitPool* pool;
+  SplitPoint* split;  // Split point of the move this thread is searching
+  // Move ordering and principal variation search, false for row-major order
+  bool ordering;
+  // Last two moves to cause a cutoff at each depth, TT_NO_MOVE if none
+  int killers[SIZE * SIZE][2];
+  // Cutoffs caused by each move for each player, weighted by draft
+  unsigned long history[2][SIZE * SIZE];
+  int root_guess;  // Root score of the previous iteration, INT_MIN if none
+#ifdef SEARCH_STATS
+  SearchStats stats;  // Filled in alongside nodes, which it does not count
+#endif
+} SearchState;
+
+/* A helper thread of a parallel search, with its own copy of the board */
+typedef struct {
+  pthread_t thread;
+  Board board;
+  SearchState state;
+  SplitPool* pool;
+} RootWorker;
+
+/**
+ * @brief Get the number of plies a node is searched to.
+ *
+ * Nodes at max_depth score 0 without being evaluated, so the node one ply
+ * above only sees its children's terminal states.
+ *
+ * @param board Pointer to the Board structure.
+ * @param state Pointer to the SearchState structure.
+ * @param depth Current depth in the game tree.
+ * @return int Plies below the node whose outcome is taken into account.
+ */
+static int search_draft(const Board* board, const SearchState* state,
+                        int depth) {
+  int empty = SIZE * SIZE - board->move_count;
+  int limit = state->max_depth - 1 - depth;
+  return (limit < empty) ? limit : empty;
+}
+
+/**
+ * @brief Pack a root score and move index into one key, so both can be
+ * updated together by a single atomic operation.
+ *
+ * Keys order by score, then by lowest index, so the best move is the one with
+ * the highest key.
+ *
+ * @param score Score of the root move.
+ * @param index Index of the root move.
+ * @return long long The root key, never negative.
+ */
+static long long root_key(int score, int index) {
+  return ((long long)score - INT_MIN) << 8 | (SIZE * SIZE - 1 - index);
+}
+
+/**
+ * @brief Get the score of a root key.
+ * @param key The root key.
+ * @return int The score packed by root_key().
+ */
+static int root_key_score(long long key) {
+  return (int)((key >> 8) + INT_MIN);
+}
+
+/**
+ * @brief Get the move index of a root key.
+ * @param key The root key.
+ * @return int The move index packed by root_key().
+ */
+static int root_key_index(long long key) {
+  return SIZE * SIZE - 1 - (int)(key & 0xFF);
+}
+
+/**
+ * @brief Check whether a split point or one above it had a cutoff, which
+ * makes the search of its moves pointless.
+ * @param split Pointer to the SplitPoint structure, or NULL.
+ * @return true if the moves of the split point need no further search.
+ */
+static bool split_cancelled(const SplitPoint* split) {
+  for (; split; split = split->parent) {
+    if (__atomic_load_n(&split->cancelled, __ATOMIC_RELAXED)) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Check whether a thread of the search has hit a limit.
+ * @param state Pointer to the SearchState structure.
+ * @return true if the whole search must stop.
+ */
+static bool search_stopped(const SearchState* state) {
+  return state->stop && __atomic_load_n(state->stop, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Count a node, check it against the node budget, and check the
+ * deadline every few nodes.
+ *
+ * A cutoff at a split point above also stops the search, but only of the
+ * move this thread took from it.
+ *
+ * @param state Pointer to the SearchState structure.
+ * @return true if the search must stop.
+ */
+static bool out_of_resources(SearchState* state) {
+  if (state->aborted) return true;
+  if (search_stopped(state) || split_cancelled(state->split)) {
+    state->aborted = true;
+    return true;
+  }
+  state->nodes++;
+  if (state->node_budget > 0 && state->nodes > state->node_budget) {
+    state->aborted = true;
+  } else if (state->deadline_ms > 0 &&
+             state->nodes % DEADLINE_CHECK_INTERVAL == 0 &&
+             timer_now_ms() >= state->deadline_ms) {
+    state->aborted = true;
+  }
+  // Tell the other threads, whose searches stopping here would not show
+  if (state->aborted && state->stop) {
+    __atomic_store_n(state->stop, 1, __ATOMIC_RELAXED);
+  }
+  return state->aborted;
+}
+
+/**
+ * @brief Move a cell to the front of a move list, keeping the others in order.
+ * @param cells Array of moves.
+ * @param num_moves Number of moves in the array.
+ * @param index Cell index (row * SIZE + col) of the move to try first.
+ */
+static void move_to_front(Cell cells[], int num_moves, int index) {
+  for (int m = 0; m < num_moves; m++) {
+    if (cells[m].row * SIZE + cells[m].col != index) continue;
+    Cell first = cells[m];
+    for (; m > 0; m--) cells[m] = cells[m - 1];
+    cells[0] = first;
+    return;
+  }
+}
+
+/**
+ * @brief Order moves so the ones most likely to cause a cutoff come first.
+ *
+ * Moves are ranked by the best move from the transposition table, then
+ * immediate wins, then blocks of the opponent's wins, then the killer moves
+ * of the depth, then the history table, with ties broken by the number of
+ * lines through the cell so the center and corners come before the edges.
+ *
+ * @param board Pointer to the Board structure.
+ * @param state Pointer to the SearchState structure.
+ * @param cells Array of moves, sorted in place.
+ * @param num_moves Number of moves in the array.
+ * @param tt_move Cell index of the move from the table, or TT_NO_MOVE.
+ * @param depth Current depth in the game tree.
+ */
+static void order_moves(const Board* board, const SearchState* state,
+                        Cell cells[], int num_moves, int tt_move, int depth) {
+  Player player = board->current_player;
+  Player opponent = (player == PLAYER_X) ? PLAYER_O : PLAYER_X;
+  const unsigned long* history = state->history[player == PLAYER_X ? 0 : 1];
+  const long long tier = 1LL << 40;  // Above any history score
+
+  long long keys[SIZE * SIZE];
+  for (int m = 0; m < num_moves; m++) {
+    int index = cells[m].row * SIZE + cells[m].col;
+    long long key =
+        (long long)history[index] * 64 + count_cell_lines(&cells[m]);
+    if (index == tt_move) {
+      key += 5 * tier;
+    } else if (is_winning_move(board, &cells[m], player)) {
+      key += 4 * tier;
+    } else if (is_winning_move(board, &cells[m], opponent)) {
+      key += 3 * tier;
+    } else if (index == state->killers[depth][0]) {
+      key += 2 * tier;
+    } else if (index == state->killers[depth][1]) {
+      key += tier;
+    }
+    keys[m] = key;
+  }
+
+  // Insertion sort, stable so equal moves stay in row-major order
+  for (int m = 1; m < num_moves; m++) {
+    Cell cell = cells[m];
+    long long key = keys[m];
+    int i = m;
+    for (; i > 0 && keys[i - 1] < key; i--) {
+      cells[i] = cells[i - 1];
+      keys[i] = keys[i - 1];
+    }
+    cells[i] = cell;
+    keys[i] = key;
+  }
+}
+
+/**
+ * @brief Remember a move that caused a cutoff so it is tried early elsewhere.
+ * @param board Pointer to the Board structure.
+ * @param state Pointer to the SearchState structure.
+ * @param cell Pointer to the move that caused the cutoff.
+ * @param depth Current depth in the game tree.
+ * @param draft Plies searched below the node, cutoffs near the root weigh more.
+ */
+static void record_cutoff(const Board* board, SearchState* state,
+                          const Cell* cell, int depth, int draft) {
+  int index = cell->row * SIZE + cell->col;
+  int* killers = state->killers[depth];
+  if (killers[0] != index) {
+    killers[1] = killers[0];
+    killers[0] = index;
+  }
+  int p = (board->current_player == PLAYER_X) ? 0 : 1;
+  state->history[p][index] += (draft > 0) ? (unsigned long)(draft * draft) : 1;
+}
+
+/**
+ * @brief Convert a score for storing in the transposition table.
+ *
+ * Wins are stored as distance from the node rather than from the root, and
+ * from the point of view of the player to move, so entries stay valid from
+ * any root and for either AI player.
+ *
+ * @param score Score from the AI player's point of view.
+ * @param to_move_is_ai true if the AI player is to move at the node.
+ * @param depth Current depth in the game tree.
+ * @return int The score to store.
+ */
+static int score_to_tt(int score, bool to_move_is_ai, int depth) {
+  if (score > 0) score += depth;
+  if (score < 0) score -= depth;
+  return to_move_is_ai ? score : -score;
+}
+
+/**
+ * @brief Convert a score read from the transposition table, the inverse of
+ * score_to_tt().
+ * @param score Score read from the table.
+ * @param to_move_is_ai true if the AI player is to move at the node.
+ * @param depth Current depth in the game tree.
+ * @return int Score from the AI player's point of view.
+ */
+static int score_from_tt(int score, bool to_move_is_ai, int depth) {
+  if (!to_move_is_ai) score = -score;
+  if (score > 0) score -= depth;
+  if (score < 0) score += depth;
+  return score;
+}
+
+/**
+ * @brief Swap lower and upper bounds when the score is negated.
+ * @param bound The bound to convert.
+ * @param negate true if the score is negated.
+ * @return TTBound The converted bound.
+ */
+static TTBound flip_bound(TTBound bound, bool negate) {
+  if (!negate || bound == TT_EXACT) return bound;
+  return (bound == TT_LOWER) ? TT_UPPER : TT_LOWER;
+}
+
+static int minimax(Board* board, SearchState* state, bool is_max, int alpha,
+                   int beta, int depth);
+
+/**
+ * @brief Check whether a split point is the given one or below it.
+ * @param split Pointer to the SplitPoint structure.
+ * @param ancestor Pointer to the SplitPoint structure it may be below.
+ * @return true if split is ancestor or one of the split points below it.
+ */
+static bool split_below(const SplitPoint* split, const SplitPoint* ancestor) {
+  for (; split; split = split->parent) {
+    if (split == ancestor) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Find a split point with moves left to hand out.
+ *
+ * The shallowest is picked, as its moves have the largest trees. The owner of
+ * a split point only helps below it, so anything it takes on finishes before
+ * its own node can.
+ *
+ * @param pool Pointer to the SplitPool structure, locked.
+ * @param owner Split point the thread waits for, or NULL if it waits for none.
+ * @return SplitPoint* The split point, or NULL if there is none.
+ */
+static SplitPoint* find_split_point(const SplitPool* pool,
+                                    const SplitPoint* owner) {
+  SplitPoint* found = NULL;
+  for (int i = 0; i < pool->num_points; i++) {
+    SplitPoint* split = pool->points[i];
+    if (split->next_move >= split->num_moves || split_cancelled(split)) {
+      continue;
+    }
+    if (found && split->depth >= found->depth) continue;
+    if (owner && !split_below(split, owner)) continue;
+    found = split;
+  }
+  return found;
+}
+
+/**
+ * @brief Take the next move of a split point, search it and merge its score.
+ *
+ * The move is searched on a copy of the node with the window the split point
+ * had when it was taken. A search stopped by a cutoff above only drops this
+ * move, as the thread that took it has other work to go back to.
+ *
+ * @param state Pointer to the SearchState structure of this thread.
+ * @param pool Pointer to the SplitPool structure, locked on entry and return.
+ * @param split Pointer to the SplitPoint structure.
+ */
+static void search_split_move(SearchState* state, SplitPool* pool,
+                              SplitPoint* split) {
+  int m = split->next_move++;
+  split->busy++;
+  int alpha = split->alpha;
+  int beta = split->beta;
+  bool is_max = split->is_max;
+  int depth = split->depth;
+  pthread_mutex_unlock(&pool->lock);
+
+  Board board;
+  copy_board(&split->board, &board);
+  make_move(&board, &split->moves[m]);
+  SplitPoint* outer = state->split;
+  state->split = split;
+  int score;
+  if (!state->ordering) {
+    score = minimax(&board, state, !is_max, alpha, beta, depth + 1);
+  } else {
+    // Younger moves get a null window first, as in minimax()
+    int null_alpha = is_max ? alpha : beta - 1;
+    score = minimax(&board, state, !is_max, null_alpha, null_alpha + 1,
+                    depth + 1);
+    if (!state->aborted && score > alpha && score < beta) {
+      STATS_ADD(state, researches);
+      score = minimax(&board, state, !is_max, alpha, beta, depth + 1);
+    }
+  }
+  state->split = outer;
+  bool dropped = state->aborted;
+  if (!search_stopped(state)) state->aborted = false;
+
+  pthread_mutex_lock(&pool->lock);
+  if (!dropped && !split->cancelled) {
+    if (split->is_max) {
+      if (score > split->best_score) {
+        split->best_score = score;
+        split->best_move = m;
+      }
+      if (split->best_score > split->alpha) split->alpha = split->best_score;
+    } else {
+      if (score < split->best_score) {
+        split->best_score = score;
+        split->best_move = m;
+      }
+      if (split->best_score < split->beta) split->beta = split->best_score;
+    }
+    if (split->beta <= split->alpha) {
+      split->cutoff_move = m;
+      __atomic_store_n(&split->cancelled, 1, __ATOMIC_RELAXED);
+    }
+  }
+  split->busy--;
+  pthread_cond_broadcast(&pool->changed);
+}
+
+/**
+ * @brief Wait for work to be added or finished, counted as an idle thread.
+ * @param pool Pointer to the SplitPool structure, locked.
+ */
+static void wait_for_work(SplitPool* pool) {
+  __atomic_add_fetch(&pool->idle, 1, __ATOMIC_RELAXED);
+  pthread_cond_wait(&pool->changed, &pool->lock);
+  __atomic_sub_fetch(&pool->idle, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Share the younger moves of a node with idle threads and search them
+ * alongside, once the eldest has set a bound (Young Brothers Wait).
+ *
+ * While the other threads finish the moves they took, this one helps with
+ * the split points below the node instead of waiting.
+ *
+ * @param board Pointer to the Board structure, at the node.
+ * @param state Pointer to the SearchState structure of this thread.
+ * @param cells Moves of the node, the eldest of which has been searched.
+ * @param num_moves Number of moves.
+ * @param is_max true if the node is the maximizing player's.
+ * @param depth Depth of the node in the game tree.
+ * @param alpha Pointer to the alpha value of the node, updated.
+ * @param beta Pointer to the beta value of the node, updated.
+ * @param best_score Pointer to the best score of the node so far, updated.
+ * @param best_move Pointer to the index of the best move so far, updated.
+ * @return true if every move was searched or cut off, false if the search of
+ * the node stopped.
+ */
+static bool split_node(Board* board, SearchState* state, const Cell cells[],
+                       int num_moves, bool is_max, int depth, int* alpha,
+                       int* beta, int* best_score, int* best_move) {
+  SplitPool* pool = state->pool;
+  SplitPoint split = {
+      .parent = state->split,
+      .num_moves = num_moves,
+      .next_move = 1,
+      .busy = 0,
+      .is_max = is_max,
+      .depth = depth,
+      .alpha = *alpha,
+      .beta = *beta,
+      .best_score = *best_score,
+      .best_move = *best_move,
+      .cutoff_move = -1,
+      .cancelled = 0,
+  };
+  copy_board(board, &split.board);
+  memcpy(split.moves, cells, num_moves * sizeof(Cell));
+
+  pthread_mutex_lock(&pool->lock);
+  pool->points[pool->num_points++] = &split;
+  pthread_cond_broadcast(&pool->changed);
+  for (;;) {
+    SplitPoint* work =
+        search_stopped(state) ? NULL : find_split_point(pool, &split);
+    if (work) {
+      search_split_move(state, pool, work);
+    } else if (split.busy > 0) {
+      wait_for_work(pool);
+    } else {
+      break;
+    }
+  }
+  for (int i = 0; i < pool->num_points; i++) {
+    if (pool->points[i] == &split) {
+      pool->points[i] = pool->points[--pool->num_points];
+      break;
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  // A cutoff above makes the result pointless, a limit leaves it incomplete
+  if (search_stopped(state) || split_cancelled(split.parent)) {
+    state->aborted = true;
+    return false;
+  }
+  *alpha = split.alpha;
+  *beta = split.beta;
+  *best_score = split.best_score;
+  *best_move = split.best_move;
+  if (split.cutoff_move >= 0) {
+    STATS_ADD(state, cutoffs[split.cutoff_move]);
+    if (state->ordering) {
+      record_cutoff(board, state, &cells[split.cutoff_move], depth,
+                    search_draft(board, state, depth));
+    }
+  }
+  return true;
+}
 
 /**
  * @brief Evaluates the board state using the minimax algorithm with alpha-beta
  * pruning.
+ *
+ * Moves are made and undone on the given board in place, so it is left
+ * unchanged when this returns.
+ *
  * @param board Pointer to the Board structure.
- * @param handicap if true, limit depth to improve performance and introduce
- * inaccuracy
+ * @param state Pointer to the SearchState structure.
  * @param is_max true if the current layer is maximizing player, false if
  * minimizing
  * @param alpha Alpha value for pruning.
@@ -23,89 +569,894 @@
  * @param depth Current depth in the game tree.
  * @return int minimax score for the current board state
  */
-static int minimax(const Board* board, Player ai_player, bool handicap,
-                   bool is_max, int alpha, int beta, int depth) {
-  if (handicap && depth >= HANDICAP_MAX_DEPTH) return 0;
+static int minimax(Board* board, SearchState* state, bool is_max, int alpha,
+                   int beta, int depth) {
+  if (depth >= state->max_depth || out_of_resources(state)) return 0;
+  // Root moves are at depth 0, one ply below the root
+  STATS_DEPTH(state, depth + 1);
 
   // Evaluate terminal states
   Winner result = check_winner(board, NULL);
+  if (result != ONGOING) STATS_ADD(state, terminal_nodes);
   if (result == DRAW) return 0;
   if (result == WIN_X || result == WIN_O) {
     int score = SIZE * SIZE - depth;
     Player winner = (result == WIN_X) ? PLAYER_X : PLAYER_O;
-    return (ai_player == winner) ? score : -score;
+    return (state->ai_player == winner) ? score : -score;
+  }
+
+  // Reuse an earlier search of this position if it went at least as deep
+  int draft = search_draft(board, state, depth);
+  bool use_tt = state->tt && draft > 0;
+  int tt_move = TT_NO_MOVE;
+  if (use_tt) {
+    TTData entry;
+    bool found = tt_probe(state->tt, board->hash, &entry);
+    if (found) tt_move = entry.move;
+    if (found && entry.draft >= draft) {
+      int score = score_from_tt(entry.score, is_max, depth);
+      TTBound bound = flip_bound(entry.bound, !is_max);
+      if (bound == TT_LOWER && score > alpha) alpha = score;
+      if (bound == TT_UPPER && score < beta) beta = score;
+      if (bound == TT_EXACT || alpha >= beta) {
+        STATS_ADD(state, tt_hits);
+        return score;
+      }
+    }
+  }
+  // Pick up a better root score found by another thread since this started
+  if (state->shared_best) {
+    long long key = __atomic_load_n(state->shared_best, __ATOMIC_RELAXED);
+    int shared = root_key_score(key);
+    if (key != ROOT_NONE && shared - 1 > alpha && shared - 1 < beta) {
+      alpha = shared - 1;
+    }
   }
+  int window_alpha = alpha;
+  int window_beta = beta;
 
   // Find all possible moves on the board
   Cell empty_cells[SIZE * SIZE];
   int num_moves = find_empty_cells(board, empty_cells, SIZE * SIZE);
+  if (state->ordering) {
+    order_moves(board, state, empty_cells, num_moves, tt_move, depth);
+  } else if (tt_move != TT_NO_MOVE) {
+    // Try the best move of a shallower search first
+    move_to_front(empty_cells, num_moves, tt_move);
+  }
 
-  if (is_max) {
-    // Maximizing player (AI)
-    int highest_score = INT_MIN;
-    for (int m = 0; m < num_moves; m++) {
-      // Make a copy of the board and make a move
-      Board temp_board;
-      copy_board(board, &temp_board);
-      Cell cell = empty_cells[m];
-      make_move(&temp_board, &cell);
-      int score = minimax(&temp_board, ai_player, handicap, false, alpha, beta,
-                          depth + 1);
-      // Find the highest score
-      if (score > highest_score) highest_score = score;
-      // Apply alpha-beta pruning
-      if (highest_score > alpha) alpha = highest_score;
-      if (beta <= alpha) break;
-    }
-    return highest_score;
+  int best_score = is_max ? INT_MIN : INT_MAX;
+  int best_move = TT_NO_MOVE;
+  for (int m = 0; m < num_moves; m++) {
+    // Make the move, search it, then take it back
+    make_move(board, &empty_cells[m]);
+    int score;
+    if (m == 0 || !state->ordering) {
+      score = minimax(board, state, !is_max, alpha, beta, depth + 1);
+    } else {
+      // Principal variation search: a null window only proves whether the
+      // move beats the best so far, and the few that do are searched again
+      int null_alpha = is_max ? alpha : beta - 1;
+      score = minimax(board, state, !is_max, null_alpha, null_alpha + 1,
+                      depth + 1);
+      if (!state->aborted && score > alpha && score < beta) {
+        STATS_ADD(state, researches);
+        score = minimax(board, state, !is_max, alpha, beta, depth + 1);
+      }
+    }
+    undo_move(board);
+    // Scores past a limit are incomplete, so nothing can be trusted
+    if (state->aborted) return 0;
+    if (is_max) {
+      // Maximizing player (AI) looks for the highest score
+      if (score > best_score) {
+        best_score = score;
+        best_move = m;
+      }
+      if (best_score > alpha) alpha = best_score;
+    } else {
+      // Minimizing player (Simulated opponent) looks for the lowest score
+      if (score < best_score) {
+        best_score = score;
+        best_move = m;
+      }
+      if (best_score < beta) beta = best_score;
+    }
+    // Apply alpha-beta pruning
+    if (beta <= alpha) {
+      STATS_ADD(state, cutoffs[m]);
+      if (state->ordering) {
+        record_cutoff(board, state, &empty_cells[m], depth, draft);
+      }
+      break;
+    }
+    // Once the eldest move has set a bound, idle threads can help with the
+    // others if they have enough left to search
+    if (m == 0 && num_moves > 2 && draft >= SPLIT_MIN_DRAFT && state->pool &&
+        __atomic_load_n(&state->pool->idle, __ATOMIC_RELAXED) > 0) {
+      if (!split_node(board, state, empty_cells, num_moves, is_max, depth,
+                      &alpha, &beta, &best_score, &best_move)) {
+        return 0;
+      }
+      break;
+    }
+  }
+
+  if (use_tt) {
+    // Scores outside the window searched are only bounds on the true value
+    TTBound bound = TT_EXACT;
+    if (best_score <= window_alpha) bound = TT_UPPER;
+    if (best_score >= window_beta) bound = TT_LOWER;
+    Cell move = empty_cells[best_move];
+    TTData entry = {
+        .score = score_to_tt(best_score, is_max, depth),
+        .draft = draft,
+        .bound = flip_bound(bound, !is_max),
+        .move = move.row * SIZE + move.col,
+    };
+    tt_store(state->tt, board->hash, &entry);
+  }
+  return best_score;
+}
+
+/**
+ * @brief Bitboard version of minimax(), see above for details.
+ *
+ * Bitboards carry no Zobrist key, so this search does not use a
+ * transposition table.
+ *
+ * @param bitboard Bitboard state, passed by value as it is only two masks.
+ * @param ai_player The player the search maximises for.
+ * @param to_move The player whose turn it is on this bitboard.
+ * @param handicap if true, limit depth to improve performance and introduce
+ * inaccuracy
+ * @return int minimax score for the current bitboard state
+ */
+static int minimax_bb(BitBoard bitboard, Player ai_player, Player to_move,
+                      bool handicap, bool is_max, int alpha, int beta,
+                      int depth) {
+  if (handicap && depth >= HANDICAP_MAX_DEPTH) return 0;
+
+  // Evaluate terminal states
+  Winner result = bb_check_winner(&bitboard);
+  if (result == DRAW) return 0;
+  if (result == WIN_X || result == WIN_O) {
+    int score = SIZE * SIZE - depth;
+    Player winner = (result == WIN_X) ? PLAYER_X : PLAYER_O;
+    return (ai_player == winner) ? score : -score;
+  }
+
+  Player next = (to_move == PLAYER_X) ? PLAYER_O : PLAYER_X;
+  int best_score = is_max ? INT_MIN : INT_MAX;
+  // Walk the empty cells in row-major order, lowest bit first
+  for (BitMask empty = bb_empty_mask(&bitboard); empty; empty &= empty - 1) {
+    BitMask bit = empty & (BitMask)-empty;
+    BitBoard child = bitboard;
+    if (to_move == PLAYER_X) {
+      child.x |= bit;
+    } else {
+      child.o |= bit;
+    }
+    int score = minimax_bb(child, ai_player, next, handicap, !is_max, alpha,
+                           beta, depth + 1);
+    if (is_max) {
+      if (score > best_score) best_score = score;
+      if (best_score > alpha) alpha = best_score;
+    } else {
+      if (score < best_score) best_score = score;
+      if (best_score < beta) beta = best_score;
+    }
+    if (beta <= alpha) break;
+  }
+  return best_score;
+}
+
+/**
+ * @brief Shuffle candidate moves and keep only HANDICAP_MAX_SAMPLES of them.
+ * @param cells Array of candidate moves, shuffled in place.
+ * @param num_moves Number of candidate moves.
+ * @param rng Pointer to the random number generator.
+ * @return int The number of moves left to evaluate.
+ */
+static int sample_moves(Cell cells[], int num_moves, Rng* rng) {
+  if (num_moves <= HANDICAP_MAX_SAMPLES) return num_moves;
+  // Fisher-Yates shuffle
+  for (int i = num_moves - 1; i > 0; --i) {
+    int j = (int)rng_bounded(rng, (uint32_t)(i + 1));
+    Cell tmp = cells[i];
+    cells[i] = cells[j];
+    cells[j] = tmp;
+  }
+  return HANDICAP_MAX_SAMPLES;
+}
+
+/**
+ * @brief Sample the root moves of a handicapped search.
+ *
+ * Moves are sampled from every empty cell, so a symmetry class is as likely
+ * to be tried as its number of cells. Samples in the same class lead to
+ * equivalent positions, so only the first of each is kept.
+ *
+ * @param board Pointer to the Board structure, restored before returning.
+ * @param cells Output array of SIZE * SIZE moves.
+ * @param rng Pointer to the random number generator.
+ * @return int The number of moves left to evaluate.
+ */
+static int sample_unique_moves(Board* board, Cell cells[], Rng* rng) {
+  int num_moves = find_empty_cells(board, cells, SIZE * SIZE);
+  num_moves = sample_moves(cells, num_moves, rng);
+
+  CellState canonical[HANDICAP_MAX_SAMPLES][SIZE][SIZE];
+  int num_unique = 0;
+  for (int m = 0; m < num_moves; m++) {
+    make_move(board, &cells[m]);
+    Board child;
+    canonical_board(board, &child);
+    undo_move(board);
+    bool seen = false;
+    for (int s = 0; s < num_unique && !seen; s++) {
+      seen = memcmp(canonical[s], child.cells, sizeof(child.cells)) == 0;
+    }
+    if (seen) continue;
+    memcpy(canonical[num_unique], child.cells, sizeof(child.cells));
+    cells[num_unique++] = cells[m];
+  }
+  return num_unique;
+}
+
+/**
+ * @brief Search the first root move, which sets the bound for the others.
+ *
+ * When an earlier iteration left a root score, the move is first searched
+ * with a narrow aspiration window around it, and again with the full window
+ * if its score falls outside.
+ *
+ * @param board Pointer to the Board structure, with the move made.
+ * @param state Pointer to the SearchState structure.
+ * @return int The exact score of the move.
+ */
+static int search_eldest(Board* board, SearchState* state) {
+  if (state->ordering && state->root_guess != INT_MIN) {
+    int alpha = state->root_guess - ASPIRATION_WINDOW;
+    int beta = state->root_guess + ASPIRATION_WINDOW;
+    int score = minimax(board, state, false, alpha, beta, 0);
+    if (state->aborted || (score > alpha && score < beta)) return score;
+    STATS_ADD(state, researches);
+  }
+  return minimax(board, state, false, INT_MIN, INT_MAX, 0);
+}
+
+/**
+ * @brief Search a root move and make it the best so far if it beats it.
+ *
+ * A move only replaces the best so far if it scores higher, or ties it from
+ * a lower index, so the lowest index wins ties no matter which thread
+ * finishes first. Each move is searched with alpha just below the score it
+ * needs. With move ordering, a null window first checks whether it gets
+ * there at all, and only moves that do are searched again with a wide window.
+ *
+ * @param board Pointer to the Board structure, searched in place.
+ * @param state Pointer to the SearchState structure of this thread.
+ * @param queue Pointer to the RootQueue structure.
+ * @param m Index of the root move.
+ */
+static void search_root_move(Board* board, SearchState* state,
+                             RootQueue* queue, int m) {
+  long long best = __atomic_load_n(&queue->best, __ATOMIC_RELAXED);
+  make_move(board, &queue->cells[m]);
+  int score;
+  if (best == ROOT_NONE) {
+    score = search_eldest(board, state);
   } else {
-    // Minimizing player (Simulated opponent)
-    int lowest_score = INT_MAX;
-    for (int m = 0; m < num_moves; m++) {
-      // Similar to maximizing player but looks for lowest score
-      Board temp_board;
-      copy_board(board, &temp_board);
-      Cell cell = empty_cells[m];
-      make_move(&temp_board, &cell);
-      int score = minimax(&temp_board, ai_player, handicap, true, alpha, beta,
-                          depth + 1);
-      if (score < lowest_score) lowest_score = score;
-      if (lowest_score < beta) beta = lowest_score;
-      if (beta <= alpha) break;
-    }
-    return lowest_score;
-  }
-}
-
-Cell minimax_find_move(const Board* board, bool handicap) {
-  Player ai_player = board->current_player;
-  Cell best_move = {-1, -1};
-  int best_score = INT_MIN;
+    int needed = root_key_score(best);
+    if (m > root_key_index(best)) needed++;
+    if (state->ordering) {
+      score = minimax(board, state, false, needed - 1, needed, 0);
+      if (!state->aborted && score >= needed) {
+        STATS_ADD(state, researches);
+        score = minimax(board, state, false, needed - 1, INT_MAX, 0);
+      }
+    } else {
+      score = minimax(board, state, false, needed - 1, INT_MAX, 0);
+    }
+  }
+  undo_move(board);
+  if (state->aborted) {
+    __atomic_store_n(&queue->stop, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  // Moves that fall short of the score they need rank below the best, so
+  // only exact scores raise it, unless another thread raised it further
+  long long key = root_key(score, m);
+  while (key > best &&
+         !__atomic_compare_exchange_n(&queue->best, &best, key, false,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+/**
+ * @brief Search root moves and help at split points until every root move
+ * has been searched, or a thread hit a limit.
+ *
+ * Split points come first, as they belong to root moves already under way.
+ *
+ * @param board Pointer to the Board structure of this thread.
+ * @param state Pointer to the SearchState structure of this thread.
+ * @param pool Pointer to the SplitPool structure.
+ */
+static void run_search_thread(Board* board, SearchState* state,
+                              SplitPool* pool) {
+  RootQueue* queue = pool->queue;
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    bool stopped = search_stopped(state);
+    SplitPoint* work = stopped ? NULL : find_split_point(pool, NULL);
+    if (work) {
+      search_split_move(state, pool, work);
+    } else if (!stopped && queue->next_move < queue->num_moves) {
+      int m = queue->next_move++;
+      queue->active++;
+      pthread_mutex_unlock(&pool->lock);
+      search_root_move(board, state, queue, m);
+      pthread_mutex_lock(&pool->lock);
+      queue->active--;
+      pthread_cond_broadcast(&pool->changed);
+    } else if (queue->active > 0) {
+      wait_for_work(pool);
+    } else {
+      break;
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+#ifdef SEARCH_STATS
+/**
+ * @brief Add the counters of a helper thread to those of the search.
+ * @param into Pointer to the SearchStats structure of the search.
+ * @param from Pointer to the SearchStats structure of the helper.
+ */
+static void merge_stats(SearchStats* into, const SearchStats* from) {
+  into->terminal_nodes += from->terminal_nodes;
+  into->tt_hits += from->tt_hits;
+  into->researches += from->researches;
+  for (int m = 0; m < SIZE * SIZE; m++) into->cutoffs[m] += from->cutoffs[m];
+  if (from->max_depth > into->max_depth) into->max_depth = from->max_depth;
+}
+
+/**
+ * @brief Find the effective branching factor of a search tree.
+ *
+ * This is the branching factor b for which a uniform tree of the same depth
+ * has the same number of nodes, 1 + b + b^2 + ... + b^depth = nodes.
+ *
+ * @param nodes Number of nodes in the tree, including the root.
+ * @param depth Depth of the tree.
+ * @return double The effective branching factor, or 0 for an empty tree.
+ */
+static double branching_factor(unsigned long nodes, int depth) {
+  if (depth <= 0 || nodes <= 1) return 0.0;
+  // Bisect, as the tree size grows with b
+  double low = 0.0;
+  double high = (double)nodes;
+  for (int i = 0; i < 64; i++) {
+    double mid = (low + high) / 2;
+    double total = 1.0;
+    double level = 1.0;
+    for (int d = 0; d < depth && total <= nodes; d++) {
+      level *= mid;
+      total += level;
+    }
+    if (total > nodes) {
+      high = mid;
+    } else {
+      low = mid;
+    }
+  }
+  return low;
+}
+#endif
+
+/**
+ * @brief Entry point of a helper thread.
+ * @param arg Pointer to the RootWorker structure of the thread.
+ * @return void* Always NULL.
+ */
+static void* root_worker_main(void* arg) {
+  RootWorker* worker = (RootWorker*)arg;
+  run_search_thread(&worker->board, &worker->state, worker->pool);
+  return NULL;
+}
+
+/**
+ * @brief Search every root move and find the best one.
+ *
+ * With several threads, they share the younger root moves once the eldest
+ * has set a bound, and below the root the younger moves of any node whose
+ * eldest has been searched (Young Brothers Wait). So the threads have work
+ * from the start, even inside the eldest root move.
+ *
+ * @param board Pointer to the Board structure, searched in place.
+ * @param state Pointer to the SearchState structure.
+ * @param cells Array of root moves.
+ * @param num_moves Number of root moves.
+ * @param threads Number of threads to search with.
+ * @param best_score Pointer to store the highest score.
+ * @return int Index of the first move with the highest score, or -1 if a
+ * limit was hit before every move was searched.
+ */
+static int search_root(Board* board, SearchState* state, const Cell cells[],
+                       int num_moves, int threads, int* best_score) {
+  RootQueue queue = {
+      .cells = cells,
+      .num_moves = num_moves,
+      .next_move = 0,
+      .active = 0,
+      .best = ROOT_NONE,
+      .stop = 0,
+  };
+  if (threads > MAX_SEARCH_THREADS) threads = MAX_SEARCH_THREADS;
+  if (threads <= 1) {
+    for (int m = 0; m < num_moves && !state->aborted; m++) {
+      search_root_move(board, state, &queue, m);
+    }
+    if (state->aborted) return -1;
+    *best_score = root_key_score(queue.best);
+    return root_key_index(queue.best);
+  }
+
+  SplitPool pool = {.queue = &queue, .num_points = 0, .idle = 0};
+  pthread_mutex_init(&pool.lock, NULL);
+  pthread_cond_init(&pool.changed, NULL);
+  state->shared_best = &queue.best;
+  state->stop = &queue.stop;
+  state->pool = &pool;
+  // The eldest root move is taken before the helpers start, so they only
+  // find work at its split points until it has set a bound
+  queue.num_moves = 1;
+  queue.next_move = 1;
+  queue.active = 1;
+
+  RootWorker workers[MAX_SEARCH_THREADS];
+  int num_workers = 0;
+  // This thread works too, so start one helper fewer
+  for (int i = 0; i < threads - 1; i++) {
+    RootWorker* worker = &workers[num_workers];
+    copy_board(board, &worker->board);
+    worker->state = *state;
+    worker->state.nodes = 0;
+#ifdef SEARCH_STATS
+    memset(&worker->state.stats, 0, sizeof(worker->state.stats));
+#endif
+    worker->pool = &pool;
+    // Carry on with fewer threads if one cannot be started
+    if (pthread_create(&worker->thread, NULL, root_worker_main, worker) != 0) {
+      break;
+    }
+    num_workers++;
+  }
+  search_root_move(board, state, &queue, 0);
+  pthread_mutex_lock(&pool.lock);
+  queue.active--;
+  queue.num_moves = num_moves;
+  pthread_cond_broadcast(&pool.changed);
+  pthread_mutex_unlock(&pool.lock);
+  run_search_thread(board, state, &pool);
+
+  for (int i = 0; i < num_workers; i++) {
+    pthread_join(workers[i].thread, NULL);
+    state->nodes += workers[i].state.nodes;
+#ifdef SEARCH_STATS
+    merge_stats(&state->stats, &workers[i].state.stats);
+#endif
+  }
+  pthread_cond_destroy(&pool.changed);
+  pthread_mutex_destroy(&pool.lock);
+  state->shared_best = NULL;
+  state->stop = NULL;
+  state->pool = NULL;
+  if (queue.stop) {
+    state->aborted = true;
+    return -1;
+  }
+
+  *best_score = root_key_score(queue.best);
+  return root_key_index(queue.best);
+}
+
+Cell minimax_find_move(const Board* board, bool handicap, Rng* rng) {
+  SearchOptions options = {.handicap = handicap, .rng = rng, .tt = NULL};
+  return minimax_search(board, &options);
+}
+
+/**
+ * @brief Set up the state of a search from its options.
+ * @param state Pointer to the SearchState structure to initialise.
+ * @param board Pointer to the Board structure to search.
+ * @param options Pointer to the SearchOptions structure.
+ */
+static void init_search_state(SearchState* state, const Board* board,
+                              const SearchOptions* options) {
+  *state = (SearchState){
+      .ai_player = board->current_player,
+      .max_depth = options->handicap ? HANDICAP_MAX_DEPTH : INT_MAX,
+      .tt = options->tt,
+      .node_budget = options->node_budget,
+      .ordering = !options->unordered,
+      .root_guess = INT_MIN,
+  };
+  for (int d = 0; d < SIZE * SIZE; d++) {
+    state->killers[d][0] = TT_NO_MOVE;
+    state->killers[d][1] = TT_NO_MOVE;
+  }
+  if (options->stats) memset(options->stats, 0, sizeof(*options->stats));
+}
+
+/**
+ * @brief Hand the counters of a finished search to the caller.
+ * @param state Pointer to the SearchState structure.
+ * @param options Pointer to the SearchOptions structure.
+ */
+static void report_stats(const SearchState* state,
+                         const SearchOptions* options) {
+#ifdef SEARCH_STATS
+  if (options->stats) {
+    *options->stats = state->stats;
+    options->stats->nodes = state->nodes + 1;
+    options->stats->branching_factor =
+        branching_factor(options->stats->nodes, state->stats.max_depth);
+  }
+#else
+  (void)state;
+  (void)options;
+#endif
+}
 
+Cell minimax_search(const Board* board, const SearchOptions* options) {
+  SearchState state;
+  init_search_state(&state, board, options);
+
+  // Search the canonical orientation, which is also the copy searched in place
+  Board board_copy;
+  int transform = canonical_board(board, &board_copy);
+
+  // Symmetric moves lead to equivalent positions, so only search one of each,
+  // randomly sampled if handicap is enabled
   Cell empty_cells[SIZE * SIZE];
-  int num_moves = find_empty_cells(board, empty_cells, SIZE * SIZE);
+  int num_moves =
+      options->handicap
+          ? sample_unique_moves(&board_copy, empty_cells, options->rng)
+          : find_unique_moves(&board_copy, empty_cells, SIZE * SIZE);
+  if (num_moves == 0) return (Cell){-1, -1};
+
+  // Thread scheduling would make the number of nodes searched vary, and
+  // small searches are over before the threads would have started
+  int threads = options->threads;
+  if (options->node_budget > 0 ||
+      SIZE * SIZE - board->move_count < PARALLEL_MIN_EMPTY) {
+    threads = 1;
+  }
+
+  int best_index = 0;
+  int best_score;
+  if (options->time_limit_ms <= 0 && options->node_budget == 0) {
+    best_index = search_root(&board_copy, &state, empty_cells, num_moves,
+                             threads, &best_score);
+  } else {
+    // Deepen until the search reaches the end of the game or its depth limit
+    if (options->time_limit_ms > 0) {
+      state.deadline_ms = timer_now_ms() + options->time_limit_ms;
+    }
+    int final_depth = SIZE * SIZE - board_copy.move_count;
+    if (state.max_depth < final_depth) final_depth = state.max_depth;
+    for (int depth = 1; depth <= final_depth; depth++) {
+      state.max_depth = depth;
+      int index = search_root(&board_copy, &state, empty_cells, num_moves,
+                              threads, &best_score);
+      if (index < 0) break;
+      state.root_guess = best_score;
+      // Keep the best move of the last finished iteration and try it first
+      Cell* best = &empty_cells[index];
+      move_to_front(empty_cells, num_moves, best->row * SIZE + best->col);
+      best_index = 0;
+    }
+  }
+
+  report_stats(&state, options);
+
+  // Map the move back to the orientation of the original board
+  return inverse_transform_cell(&empty_cells[best_index], transform);
+}
+
+int minimax_score_moves(const Board* board, const SearchOptions* options,
+                        double scores[SIZE * SIZE]) {
+  for (int i = 0; i < SIZE * SIZE; i++) scores[i] = MOVE_SCORE_NONE;
+  if (!board || !options || check_winner(board, NULL) != ONGOING) return -1;
 
+  SearchState state;
+  init_search_state(&state, board, options);
   Board board_copy;
   copy_board(board, &board_copy);
 
-  // Randomly sample moves using Fisher-Yates shuffle if handicap is enabled.
-  if (handicap && num_moves > HANDICAP_MAX_SAMPLES) {
-    for (int i = num_moves - 1; i > 0; --i) {
-      int j = rand() % (i + 1);
-      Cell tmp = empty_cells[i];
-      empty_cells[i] = empty_cells[j];
-      empty_cells[j] = tmp;
+  Cell moves[SIZE * SIZE];
+  int num_moves = find_empty_cells(&board_copy, moves, SIZE * SIZE);
+  // Canonical form of the position after each move
+  CellState canonical[SIZE * SIZE][SIZE][SIZE];
+  for (int m = 0; m < num_moves; m++) {
+    int index = moves[m].row * SIZE + moves[m].col;
+    make_move(&board_copy, &moves[m]);
+    Board child;
+    canonical_board(&board_copy, &child);
+    memcpy(canonical[m], child.cells, sizeof(child.cells));
+    // Symmetric moves lead to equivalent positions with the same score
+    for (int s = 0; s < m; s++) {
+      if (memcmp(canonical[s], canonical[m], sizeof(child.cells)) == 0) {
+        scores[index] = scores[moves[s].row * SIZE + moves[s].col];
+        break;
+      }
+    }
+    // Every move needs its exact score, so each gets the full window
+    if (scores[index] == MOVE_SCORE_NONE) {
+      scores[index] = minimax(&board_copy, &state, false, INT_MIN, INT_MAX, 0);
+    }
+    undo_move(&board_copy);
+  }
+
+  report_stats(&state, options);
+  return num_moves;
+}
+
+/**
+ * @brief Set up a frame to search all moves of a position.
+ * @param task Pointer to the MinimaxTask structure.
+ * @param frame Pointer to the MinimaxFrame structure to initialise.
+ * @param is_max true if the current layer is maximizing player, false if
+ * minimizing
+ * @param alpha Alpha value for pruning.
+ * @param beta Beta value for pruning.
+ */
+static void push_frame(MinimaxTask* task, MinimaxFrame* frame, bool is_max,
+                       int alpha, int beta) {
+  frame->num_moves = find_empty_cells(&task->board, frame->moves, SIZE * SIZE);
+  frame->next_move = 0;
+  frame->alpha = alpha;
+  frame->beta = beta;
+  frame->best_score = is_max ? INT_MIN : INT_MAX;
+  frame->best_move = -1;
+  frame->is_max = is_max;
+}
+
+/**
+ * @brief Enter the position reached by the last move, the start of a call to
+ * minimax().
+ * @param task Pointer to the MinimaxTask structure.
+ * @param score Pointer to store the score if it is known without searching.
+ * @return true if a frame was pushed to search the position's moves, false if
+ * the score is known.
+ */
+static bool enter_node(MinimaxTask* task, int* score) {
+  // The new node is one ply below the innermost frame
+  int depth = task->top;
+  task->nodes++;
+  *score = 0;
+  if (depth >= task->max_depth) return false;
+
+  Winner result = check_winner(&task->board, NULL);
+  if (result == DRAW) return false;
+  if (result == WIN_X || result == WIN_O) {
+    Player winner = (result == WIN_X) ? PLAYER_X : PLAYER_O;
+    *score = SIZE * SIZE - depth;
+    if (task->ai_player != winner) *score = -*score;
+    return false;
+  }
+
+  const MinimaxFrame* parent = &task->frames[task->top];
+  task->top++;
+  push_frame(task, &task->frames[task->top], !parent->is_max, parent->alpha,
+             parent->beta);
+  return true;
+}
+
+/**
+ * @brief Pass the score of a searched move to its frame, the end of an
+ * iteration of the move loop in minimax().
+ * @param task Pointer to the MinimaxTask structure.
+ * @param frame Pointer to the MinimaxFrame structure that made the move.
+ * @param score Score of the move.
+ */
+static void report_score(MinimaxTask* task, MinimaxFrame* frame, int score) {
+  if (task->scoring && frame == &task->frames[0]) {
+    // Keep the full window, so every root move gets its exact score
+    task->root_scores[frame->next_move - 1] = score;
+    if (score > frame->best_score) {
+      frame->best_score = score;
+      frame->best_move = frame->next_move - 1;
+    }
+    return;
+  }
+  if (frame->is_max) {
+    if (score > frame->best_score) {
+      frame->best_score = score;
+      frame->best_move = frame->next_move - 1;
+    }
+    if (frame->best_score > frame->alpha) frame->alpha = frame->best_score;
+  } else {
+    if (score < frame->best_score) {
+      frame->best_score = score;
+      frame->best_move = frame->next_move - 1;
+    }
+    if (frame->best_score < frame->beta) frame->beta = frame->best_score;
+  }
+}
+
+void minimax_task_start(MinimaxTask* task, const Board* board, bool handicap,
+                        Rng* rng) {
+  task->transform = canonical_board(board, &task->board);
+  task->ai_player = board->current_player;
+  task->max_depth = handicap ? HANDICAP_MAX_DEPTH : INT_MAX;
+  task->top = 0;
+  task->nodes = 0;
+  task->node_budget = 0;
+  task->scoring = false;
+
+  // The root is a max node whose alpha only rises on a strictly better move,
+  // so like search_root() the first move with the highest score is chosen
+  MinimaxFrame* root = &task->frames[0];
+  push_frame(task, root, true, INT_MIN, INT_MAX);
+  root->num_moves =
+      handicap ? sample_unique_moves(&task->board, root->moves, rng)
+               : find_unique_moves(&task->board, root->moves, SIZE * SIZE);
+  task->done = root->num_moves == 0;
+}
+
+void minimax_task_start_scoring(MinimaxTask* task, const Board* board,
+                                bool handicap, unsigned long node_budget) {
+  task->transform = canonical_board(board, &task->board);
+  task->ai_player = board->current_player;
+  task->final_depth = SIZE * SIZE - board->move_count;
+  if (handicap && task->final_depth > HANDICAP_MAX_DEPTH) {
+    task->final_depth = HANDICAP_MAX_DEPTH;
+  }
+  // Without a budget, the only iteration goes to the end
+  task->max_depth = (node_budget > 0) ? 1 : task->final_depth;
+  task->completed_depth = 0;
+  task->top = 0;
+  task->nodes = 0;
+  task->node_budget = node_budget;
+  task->scoring = true;
+
+  // Every move is a root move, and symmetric ones share the first's score
+  MinimaxFrame* root = &task->frames[0];
+  push_frame(task, root, true, INT_MIN, INT_MAX);
+  CellState canonical[SIZE * SIZE][SIZE][SIZE];
+  for (int m = 0; m < root->num_moves; m++) {
+    make_move(&task->board, &root->moves[m]);
+    Board child;
+    canonical_board(&task->board, &child);
+    undo_move(&task->board);
+    memcpy(canonical[m], child.cells, sizeof(child.cells));
+    task->equivalent[m] = m;
+    for (int s = 0; s < m; s++) {
+      if (memcmp(canonical[s], canonical[m], sizeof(child.cells)) == 0) {
+        task->equivalent[m] = s;
+        break;
+      }
     }
-    num_moves = HANDICAP_MAX_SAMPLES;
   }
+  task->done = root->num_moves == 0 || check_winner(board, NULL) != ONGOING;
+}
+
+bool minimax_task_step(MinimaxTask* task, unsigned long max_nodes,
+                       double max_ms) {
+  if (task->done) return true;
+  double deadline_ms = (max_ms > 0) ? timer_now_ms() + max_ms : 0.0;
+  unsigned long searched = 0;
 
+  for (;;) {
+    MinimaxFrame* frame = &task->frames[task->top];
+    if (frame->next_move < frame->num_moves && frame->alpha < frame->beta) {
+      // Symmetric root moves take the score of the one already searched
+      if (task->scoring && task->top == 0) {
+        int first = task->equivalent[frame->next_move];
+        if (first != frame->next_move) {
+          frame->next_move++;
+          report_score(task, frame, task->root_scores[first]);
+          continue;
+        }
+      }
+      // Fall back on the last finished iteration once the budget is spent
+      if (task->node_budget > 0 && task->nodes >= task->node_budget &&
+          task->completed_depth > 0) {
+        task->done = true;
+        return true;
+      }
+      // Stop between nodes, where the stack holds everything to resume
+      if (max_nodes > 0 && searched >= max_nodes) return false;
+      if (deadline_ms > 0 && searched > 0 &&
+          searched % DEADLINE_CHECK_INTERVAL == 0 &&
+          timer_now_ms() >= deadline_ms) {
+        return false;
+      }
+      searched++;
+
+      make_move(&task->board, &frame->moves[frame->next_move++]);
+      int score;
+      if (enter_node(task, &score)) continue;
+      undo_move(&task->board);
+      report_score(task, frame, score);
+      continue;
+    }
+
+    // Every move is searched or the rest were pruned, so the node is done
+    if (task->top == 0) {
+      if (!task->scoring) {
+        task->done = true;
+        return true;
+      }
+      memcpy(task->completed_scores, task->root_scores,
+             sizeof(task->root_scores));
+      task->completed_depth = task->max_depth;
+      if (task->max_depth >= task->final_depth) {
+        task->done = true;
+        return true;
+      }
+      // Search every root move again one ply deeper
+      task->max_depth++;
+      push_frame(task, frame, true, INT_MIN, INT_MAX);
+      continue;
+    }
+    int score = frame->best_score;
+    task->top--;
+    undo_move(&task->board);
+    report_score(task, &task->frames[task->top], score);
+  }
+}
+
+Cell minimax_task_result(const MinimaxTask* task) {
+  const MinimaxFrame* root = &task->frames[0];
+  if (!task->done || root->best_move < 0) return (Cell){-1, -1};
+  return inverse_transform_cell(&root->moves[root->best_move],
+                                task->transform);
+}
+
+int minimax_task_scores(const MinimaxTask* task, double scores[SIZE * SIZE]) {
+  for (int i = 0; i < SIZE * SIZE; i++) scores[i] = MOVE_SCORE_NONE;
+  if (!task->done || !task->scoring) return -1;
+
+  const MinimaxFrame* root = &task->frames[0];
+  if (task->completed_depth == 0) return 0;
+  for (int m = 0; m < root->num_moves; m++) {
+    Cell cell = inverse_transform_cell(&root->moves[m], task->transform);
+    scores[cell.row * SIZE + cell.col] = task->completed_scores[m];
+  }
+  return root->num_moves;
+}
+
+Cell minimax_find_move_bb(const BitBoard* bitboard, Player current_player,
+                          bool handicap, Rng* rng) {
+  Cell best_move = {-1, -1};
+  int best_score = INT_MIN;
+
+  Cell empty_cells[SIZE * SIZE];
+  int num_moves = bb_find_empty_cells(bitboard, empty_cells, SIZE * SIZE);
+
+  // Randomly sample moves if handicap is enabled
+  if (handicap) num_moves = sample_moves(empty_cells, num_moves, rng);
+
+  Player next = (current_player == PLAYER_X) ? PLAYER_O : PLAYER_X;
   // Evaluate moves
   for (int m = 0; m < num_moves; m++) {
     Cell cell = empty_cells[m];
-    make_move(&board_copy, &cell);
-    int score =
-        minimax(&board_copy, ai_player, handicap, false, INT_MIN, INT_MAX, 0);
-    undo_move(&board_copy);
+    BitBoard child = *bitboard;
+    BitMask bit = BB_BIT(cell.row * SIZE + cell.col);
+    if (current_player == PLAYER_X) {
+      child.x |= bit;
+    } else {
+      child.o |= bit;
+    }
+    int score = minimax_bb(child, current_player, next, handicap, false,
+                           INT_MIN, INT_MAX, 0);
     // Update best move if this move has a higher score
     if (score > best_score) {
       best_score = score;
@@ -4,16 +4,233 @@
 #include <stdbool.h>
 
 #include "board.h"
+#include "move_choice.h"
+#include "transposition.h"
 
-#define HANDICAP_MAX_DEPTH 2
-#define HANDICAP_MAX_SAMPLES 4
+#define HANDICAP_MAX_DEPTH 2    // Plies searched with handicap
+#define HANDICAP_MAX_SAMPLES 4  // Root moves sampled with handicap
+#define MAX_SEARCH_THREADS 64
+// Positions with fewer empty cells are searched single-threaded. Below this,
+// a search takes well under the time to start its threads, e.g. ~2 ms and
+// 20k nodes with 11 empty cells on a 4x4 board, so a 3x3 board never is
+#define PARALLEL_MIN_EMPTY 12
+
+/* Counters filled in by a search when built with -DSEARCH_STATS (see
+ * meson_options.txt). Otherwise they cost nothing and are left zeroed */
+typedef struct {
+  unsigned long nodes;           // Positions visited, including the root
+  unsigned long terminal_nodes;  // Positions where the game was over
+  unsigned long tt_hits;         // Positions answered by the table
+  unsigned long researches;      // Null or aspiration windows searched again
+  // Cutoffs by index of the move that caused them, 0 is the first move tried
+  unsigned long cutoffs[SIZE * SIZE];
+  int max_depth;            // Deepest ply reached below the root
+  double branching_factor;  // Effective branching factor of the search tree
+} SearchStats;
+
+typedef struct {
+  // Randomly sample root moves from every empty cell and limit depth to
+  // introduce inaccuracy
+  bool handicap;
+  // Used to sample moves, can be NULL if handicap is false
+  Rng* rng;
+  // Results of earlier searches, kept across calls to reuse them. Can be NULL
+  TranspositionTable* tt;
+  // Deepen iteratively and stop after this many milliseconds, 0 for no limit
+  double time_limit_ms;
+  // Deepen iteratively and stop after this many nodes, 0 for no limit
+  unsigned long node_budget;
+  // Threads searching in parallel, 0 or 1 for single-threaded.
+  // Ignored with a node budget, whose cost must not depend on scheduling,
+  // and for positions with fewer than PARALLEL_MIN_EMPTY empty cells
+  int threads;
+  // Filled in with the search counters if not NULL, see SearchStats
+  SearchStats* stats;
+  // Search moves in row-major order with full windows, for comparison with
+  // the default move ordering and principal variation search
+  bool unordered;
+} SearchOptions;
+
+/* A node of a resumable search, see MinimaxTask */
+typedef struct {
+  Cell moves[SIZE * SIZE];
+  int num_moves;
+  int next_move;  // Index of the next move to search
+  int alpha;
+  int beta;
+  int best_score;
+  int best_move;  // Index of the best move so far, -1 if none
+  bool is_max;
+} MinimaxFrame;
+
+/* A minimax search that runs a slice at a time. The recursion is replaced by
+ * an explicit stack, so everything needed to resume lives in the structure */
+typedef struct {
+  Board board;    // Canonical copy of the position, searched in place
+  int transform;  // Maps moves on the copy back to the original board
+  Player ai_player;
+  int max_depth;  // Nodes this deep score 0, INT_MAX for no limit
+  // frames[0] is the root, frames[d + 1] the node being searched at depth d
+  MinimaxFrame frames[SIZE * SIZE + 1];
+  int top;              // Index of the innermost frame
+  unsigned long nodes;  // Nodes searched so far, over every slice
+  unsigned long node_budget;  // Stop after this many nodes, 0 for no limit
+  // Every root move gets its exact score, see minimax_task_start_scoring()
+  bool scoring;
+  // Index of the first root move leading to the same canonical position
+  int equivalent[SIZE * SIZE];
+  int root_scores[SIZE * SIZE];  // Score of each root move once searched
+  // Deepest max_depth to search to, the last iteration with a node budget
+  int final_depth;
+  int completed_depth;  // max_depth of the last finished iteration, 0 if none
+  int completed_scores[SIZE * SIZE];  // root_scores of that iteration
+  bool done;
+} MinimaxTask;
 
 /**
  * @brief Selects a move for the AI player using the minimax algorithm.
  * @param board Pointer to the Board structure.
- * @param handicap if true, randomly sample 2 moves and limit depth to improve
+ * @param handicap if true, randomly sample HANDICAP_MAX_SAMPLES moves and
+ * limit depth to HANDICAP_MAX_DEPTH to improve performance and introduce
+ * inaccuracy
+ * @param rng Pointer to the random number generator used to sample moves. Can
+ * be NULL if handicap is false.
+ */
+Cell minimax_find_move(const Board* board, bool handicap, Rng* rng);
+
+/**
+ * @brief Selects a move for the AI player using the minimax algorithm with
+ * extra search options.
+ *
+ * With a time limit or node budget, the search deepens one ply at a time and
+ * returns the best move of the deepest iteration that finished within them.
+ * Each iteration tries the previous best moves first, from the root and from
+ * the transposition table if one is given. Unlike the time limit, the node
+ * budget gives the same move and the same cost on every device.
+ *
+ * With several threads, the younger moves of a node are only shared once its
+ * eldest has set a bound (Young Brothers Wait). Idle threads take younger root
+ * moves from a shared queue, and younger moves of any node deep enough from
+ * a shared pool of split points, so they help inside the eldest root move
+ * too. A cutoff at a split point stops the threads below it, and finished
+ * root moves raise a shared alpha that running searches pick up. The chosen
+ * move is the same as with a single thread.
+ *
+ * Below the root, moves are tried in order of the table's best move, wins,
+ * blocks, killer moves, history and lines through the cell. Only the first
+ * is searched with the full window, the others with a null window that is
+ * widened only if they turn out better. Neither changes the chosen move.
+ *
+ * @param board Pointer to the Board structure.
+ * @param options Pointer to the SearchOptions structure.
+ * @return Cell The selected move, or {-1, -1} if there is none.
+ */
+Cell minimax_search(const Board* board, const SearchOptions* options);
+
+/**
+ * @brief Score every legal move of the AI player with one minimax search.
+ *
+ * Each move gets its exact minimax value, positive for a win (sooner is
+ * higher), 0 for a draw and negative for a loss. Symmetric moves are searched
+ * once. With handicap, the depth is limited but no move is sampled, so the
+ * scores can be shaped by softmax_scored_move() or epsilon_scored_move()
+ * instead. The time limit, node budget and threads options are ignored.
+ *
+ * @param board Pointer to the Board structure.
+ * @param options Pointer to the SearchOptions structure.
+ * @param scores Filled in with the score of each cell, MOVE_SCORE_NONE for
+ * cells that are not legal moves.
+ * @return int The number of legal moves scored, or -1 if the game is over or
+ * the parameters are invalid.
+ */
+int minimax_score_moves(const Board* board, const SearchOptions* options,
+                        double scores[SIZE * SIZE]);
+
+/**
+ * @brief Start a resumable minimax search, to be run by minimax_task_step().
+ *
+ * The root moves are sampled exactly like minimax_find_move(), so with the
+ * generator in the same state both choose the same move.
+ *
+ * @param task Pointer to the MinimaxTask structure to initialise.
+ * @param board Pointer to the Board structure, copied into the task.
+ * @param handicap if true, randomly sample moves and limit depth to improve
  * performance and introduce inaccuracy
+ * @param rng Pointer to the random number generator used to sample moves. Can
+ * be NULL if handicap is false.
+ */
+void minimax_task_start(MinimaxTask* task, const Board* board, bool handicap,
+                        Rng* rng);
+
+/**
+ * @brief Start a resumable search that scores every legal move, to be run by
+ * minimax_task_step().
+ *
+ * Like minimax_score_moves(), each move gets its exact minimax value and
+ * symmetric moves are searched once. With handicap, the depth is limited but
+ * no move is sampled.
+ *
+ * With a node budget, the search deepens one ply at a time, and every move
+ * gets its score from the deepest iteration finished within the budget. The
+ * first iteration, one ply deep, always finishes, so the budget may be
+ * overrun by its few nodes.
+ *
+ * @param task Pointer to the MinimaxTask structure to initialise.
+ * @param board Pointer to the Board structure, copied into the task.
+ * @param handicap if true, limit depth to improve performance and introduce
+ * inaccuracy
+ * @param node_budget Nodes to search over every slice, 0 for no limit.
+ */
+void minimax_task_start_scoring(MinimaxTask* task, const Board* board,
+                                bool handicap, unsigned long node_budget);
+
+/**
+ * @brief Run a resumable minimax search for a limited number of nodes or
+ * time, then return so the caller can do other work in between.
+ * @param task Pointer to the MinimaxTask structure.
+ * @param max_nodes Nodes to search before returning, 0 for no limit.
+ * @param max_ms Milliseconds to search before returning, 0 for no limit.
+ * @return true once the search is finished, false if it must be stepped again.
+ */
+bool minimax_task_step(MinimaxTask* task, unsigned long max_nodes,
+                       double max_ms);
+
+/**
+ * @brief Get the move chosen by a finished resumable search.
+ * @param task Pointer to the MinimaxTask structure.
+ * @return Cell The same move as minimax_find_move(), or {-1, -1} if the
+ * search is not finished or there is no move.
+ */
+Cell minimax_task_result(const MinimaxTask* task);
+
+/**
+ * @brief Get the scores of a finished search started by
+ * minimax_task_start_scoring().
+ * @param task Pointer to the MinimaxTask structure.
+ * @param scores Filled in with the score of each cell, MOVE_SCORE_NONE for
+ * cells that are not legal moves.
+ * @return int The number of moves scored, or -1 if the search is not finished
+ * or does not score moves.
+ */
+int minimax_task_scores(const MinimaxTask* task, double scores[SIZE * SIZE]);
+
+/**
+ * @brief Selects a move for the AI player using the minimax algorithm on a
+ * bitboard.
+ *
+ * Same search as minimax_find_move, but each node only carries the two
+ * occupancy masks of the bitboard instead of a full Board, 4 bytes for boards
+ * up to 4x4 and 8 or 16 bytes for larger ones.
+ *
+ * @param bitboard Pointer to the BitBoard structure.
+ * @param current_player The player to move (the AI player).
+ * @param handicap if true, randomly sample HANDICAP_MAX_SAMPLES moves and
+ * limit depth to HANDICAP_MAX_DEPTH to improve performance and introduce
+ * inaccuracy
+ * @param rng Pointer to the random number generator used to sample moves. Can
+ * be NULL if handicap is false.
  */
-Cell minimax_find_move(const Board* board, bool handicap);
+Cell minimax_find_move_bb(const BitBoard* bitboard, Player current_player,
+                          bool handicap, Rng* rng);
 
 #endif  // MINIMAX_H
@@ -0,0 +1,243 @@
+/**
+ * @file model_file.c
+ * @brief Versioned container for model files, with a header describing the
+ * model and a checksum of its payload, read in place from a mapping.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+// mmap, open and fstat are hidden by -std=c99 unless POSIX is requested
+#define _POSIX_C_SOURCE 200112L
+
+#include "model_file.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MAGIC_LENGTH 4
+#define CRC32_POLYNOMIAL 0xEDB88320u  // IEEE 802.3, bit-reversed
+#define CELL_STATES (O + 1)           // EMPTY, X and O
+
+/**
+ * @brief Compute the CRC-32 checksum used by zlib and PNG.
+ * @param data Pointer to the data.
+ * @param size Bytes of data.
+ * @return uint32_t The checksum.
+ */
+static uint32_t crc32(const unsigned char* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Read the header of model file data and point at its payload.
+ * @param file Pointer to the ModelFile structure to fill in.
+ * @param data Pointer to the model file data.
+ * @param size Bytes of data.
+ * @return 0 on success, -1 if the header or checksum is invalid.
+ */
+static int parse(ModelFile* file, const unsigned char* data, size_t size) {
+  memset(&file->header, 0, sizeof(file->header));
+  if (size < MAGIC_LENGTH || memcmp(data, MODEL_MAGIC, MAGIC_LENGTH) != 0) {
+    // A raw struct saved before the container existed
+    file->header.version = MODEL_LEGACY_VERSION;
+    file->header.payload_size = (uint32_t)size;
+    file->payload = data;
+    return 0;
+  }
+
+  // Copied out, as embedded data is not aligned for the wider fields
+  if (size < sizeof(ModelHeader)) {
+    fprintf(stderr, "Error: Model file header is truncated\n");
+    return -1;
+  }
+  memcpy(&file->header, data, sizeof(ModelHeader));
+  const ModelHeader* header = &file->header;
+  if (header->byte_order != MODEL_BYTE_ORDER) {
+    fprintf(stderr, "Error: Model file was saved with another byte order\n");
+    return -1;
+  }
+  if (header->version > MODEL_VERSION) {
+    fprintf(stderr, "Error: Model file version %u is newer than %d\n",
+            (unsigned)header->version, MODEL_VERSION);
+    return -1;
+  }
+  if (header->header_size < sizeof(ModelHeader) ||
+      header->header_size > size ||
+      header->payload_size > size - header->header_size) {
+    fprintf(stderr, "Error: Model file is truncated\n");
+    return -1;
+  }
+  file->payload = data + header->header_size;
+  if (crc32(file->payload, header->payload_size) != header->crc) {
+    fprintf(stderr, "Error: Model file checksum does not match\n");
+    return -1;
+  }
+  return 0;
+}
+
+#ifdef _WIN32
+/**
+ * @brief Read a whole file into memory, where mmap is not available.
+ * @param path Path to the file.
+ * @param size Pointer to store the bytes read.
+ * @return void* The allocated contents, or NULL on failure.
+ */
+static void* map_file(const char* path, size_t* size) {
+  FILE* fp = fopen(path, "rb");
+  if (!fp) return NULL;
+  void* contents = NULL;
+  long length = -1;
+  if (fseek(fp, 0, SEEK_END) == 0) length = ftell(fp);
+  if (length > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+    contents = malloc((size_t)length);
+    if (contents && fread(contents, (size_t)length, 1, fp) != 1) {
+      free(contents);
+      contents = NULL;
+    }
+  }
+  fclose(fp);
+  *size = (size_t)length;
+  return contents;
+}
+
+/**
+ * @brief Free the contents of a file read by map_file().
+ * @param contents Pointer to the contents.
+ * @param size Bytes of the contents.
+ */
+static void unmap_file(void* contents, size_t size) {
+  (void)size;
+  free(contents);
+}
+#else
+/**
+ * @brief Map a whole file read-only into memory.
+ * @param path Path to the file.
+ * @param size Pointer to store the bytes mapped.
+ * @return void* The mapping, or NULL on failure.
+ */
+static void* map_file(const char* path, size_t* size) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat info;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    *size = (size_t)info.st_size;
+    mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  return (mapping == MAP_FAILED) ? NULL : mapping;
+}
+
+/**
+ * @brief Unmap a file mapped by map_file().
+ * @param mapping Pointer to the mapping.
+ * @param size Bytes of the mapping.
+ */
+static void unmap_file(void* mapping, size_t size) { munmap(mapping, size); }
+#endif
+
+int model_file_open(ModelFile* file, const char* path) {
+  if (!file || !path) return -1;
+  file->mapping = map_file(path, &file->mapping_size);
+  if (!file->mapping) return -1;
+  if (parse(file, file->mapping, file->mapping_size) != 0) {
+    fprintf(stderr, "Error: Failed to read model file '%s'\n", path);
+    model_file_close(file);
+    return -1;
+  }
+  return 0;
+}
+
+int model_file_view(ModelFile* file, const void* data, size_t size) {
+  if (!file || !data || size == 0) return -1;
+  file->mapping = NULL;
+  file->mapping_size = 0;
+  return parse(file, data, size);
+}
+
+void model_file_close(ModelFile* file) {
+  if (!file || !file->mapping) return;
+  unmap_file(file->mapping, file->mapping_size);
+  file->mapping = NULL;
+  file->mapping_size = 0;
+  file->payload = NULL;
+}
+
+int model_file_expect(const ModelFile* file, ModelType type,
+                      ModelPrecision precision, size_t payload_size) {
+  const ModelHeader* header = &file->header;
+  if (header->type != type || header->precision != precision) {
+    fprintf(stderr,
+            "Error: Model file holds model type %u of precision %u, "
+            "expected type %d of precision %d\n",
+            (unsigned)header->type, (unsigned)header->precision, (int)type,
+            (int)precision);
+    return -1;
+  }
+  if (header->board_size != SIZE || header->win_length != WIN_LENGTH ||
+      header->cell_states != CELL_STATES) {
+    fprintf(stderr,
+            "Error: Model file was built for %u-in-a-row on a %ux%u board\n",
+            (unsigned)header->win_length, (unsigned)header->board_size,
+            (unsigned)header->board_size);
+    return -1;
+  }
+  if (header->payload_size != payload_size) {
+    fprintf(stderr, "Error: Model file payload is %u bytes, expected %zu\n",
+            (unsigned)header->payload_size, payload_size);
+    return -1;
+  }
+  return 0;
+}
+
+int model_file_write(const char* path, ModelType type, ModelPrecision precision,
+                     const void* payload, size_t payload_size) {
+  if (!path || !payload || payload_size > UINT32_MAX) return -1;
+
+  ModelHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MODEL_MAGIC, MAGIC_LENGTH);
+  header.byte_order = MODEL_BYTE_ORDER;
+  header.version = MODEL_VERSION;
+  header.header_size = sizeof(ModelHeader);
+  header.type = type;
+  header.precision = precision;
+  header.board_size = SIZE;
+  header.win_length = WIN_LENGTH;
+  header.cell_states = CELL_STATES;
+  header.payload_size = (uint32_t)payload_size;
+  header.crc = crc32(payload, payload_size);
+
+  FILE* fp = fopen(path, "wb");
+  if (fp == NULL) {
+    fprintf(stderr, "Error: Failed to open output file path '%s'\n", path);
+    return -1;
+  }
+  bool written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                 fwrite(payload, payload_size, 1, fp) == 1;
+  if (fclose(fp) != 0) written = false;
+  if (!written) {
+    fprintf(stderr, "Error: Failed to write model to file path '%s'\n", path);
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef MODEL_FILE_H
+#define MODEL_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MODEL_MAGIC "TTTM"
+#define MODEL_VERSION 1              // Newest container version this reads
+#define MODEL_LEGACY_VERSION 0       // Version of raw files with no header
+#define MODEL_BYTE_ORDER 0x01020304  // Reads differently on a foreign host
+
+typedef enum {
+  MODEL_NAIVE_BAYES = 1,            // NaiveBayesModel probabilities
+  MODEL_NAIVE_BAYES_QUANTIZED = 2,  // NaiveBayesQuantized log odds
+} ModelType;
+
+typedef enum {
+  MODEL_F64 = 1,  // IEEE 754 doubles
+  MODEL_I16 = 2,  // int16_t fixed point, scaled as the model type defines
+} ModelPrecision;
+
+/* Fixed-size header at the start of every model file, followed by the payload
+ * at header_size bytes. Fields are written in the byte order of the host that
+ * saved the file, which byte_order identifies. */
+typedef struct {
+  char magic[4];          // MODEL_MAGIC, not NUL-terminated
+  uint32_t byte_order;    // MODEL_BYTE_ORDER
+  uint16_t version;       // MODEL_VERSION of the writer
+  uint16_t header_size;   // Offset of the payload, newer headers may grow
+  uint16_t type;          // ModelType
+  uint16_t precision;     // ModelPrecision
+  uint16_t board_size;    // SIZE the model was built for
+  uint16_t win_length;    // WIN_LENGTH the model was built for
+  uint16_t cell_states;   // States of each cell, EMPTY, X and O
+  uint16_t reserved;      // 0
+  uint32_t payload_size;  // Bytes of the payload
+  uint32_t crc;           // CRC-32 of the payload
+} ModelHeader;
+
+/* A model file read in place, either mapped from disk or viewed in memory */
+typedef struct {
+  ModelHeader header;
+  const unsigned char* payload;  // Points into the mapping or the memory
+  void* mapping;                 // NULL when viewing memory
+  size_t mapping_size;
+} ModelFile;
+
+/**
+ * @brief Map a model file into memory and check its header and checksum.
+ *
+ * The payload is read in place from the mapping, without copying. A file
+ * without the magic is opened as a legacy raw payload with version
+ * MODEL_LEGACY_VERSION and no checks, for the caller to accept or reject.
+ *
+ * @param file Pointer to the ModelFile structure to initialise.
+ * @param path Path to the model file.
+ * @return 0 on success, -1 if the file cannot be read or is invalid.
+ */
+int model_file_open(ModelFile* file, const char* path);
+
+/**
+ * @brief View model file data already in memory, such as an embedded blob.
+ *
+ * Checked like model_file_open(). The data must outlive the ModelFile.
+ *
+ * @param file Pointer to the ModelFile structure to initialise.
+ * @param data Pointer to the model file data.
+ * @param size Bytes of data.
+ * @return 0 on success, -1 if the data is invalid.
+ */
+int model_file_view(ModelFile* file, const void* data, size_t size);
+
+/**
+ * @brief Unmap a model file opened by model_file_open().
+ *
+ * Does nothing for views of memory. The payload must not be used afterwards.
+ *
+ * @param file Pointer to the ModelFile structure.
+ */
+void model_file_close(ModelFile* file);
+
+/**
+ * @brief Check that a model file holds the expected kind of model, built for
+ * the board of this build.
+ * @param file Pointer to an opened ModelFile structure.
+ * @param type Expected model type.
+ * @param precision Expected precision of the values.
+ * @param payload_size Expected bytes of the payload.
+ * @return 0 if the model matches, -1 otherwise.
+ */
+int model_file_expect(const ModelFile* file, ModelType type,
+                      ModelPrecision precision, size_t payload_size);
+
+/**
+ * @brief Write a model file with a header and checksum for a payload.
+ * @param path Path to the output file.
+ * @param type Type of the model.
+ * @param precision Precision of the values in the payload.
+ * @param payload Pointer to the payload.
+ * @param payload_size Bytes of the payload.
+ * @return 0 on success, -1 on failure.
+ */
+int model_file_write(const char* path, ModelType type, ModelPrecision precision,
+                     const void* payload, size_t payload_size);
+
+#endif  // MODEL_FILE_H
@@ -0,0 +1,72 @@
+/**
+ * @file move_choice.c
+ * @brief Choice of a move from the scores of every legal move, greedily or
+ * sampled to weaken play.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+#include "move_choice.h"
+
+#include <math.h>
+
+/**
+ * @brief Draw a uniform random number.
+ * @param rng Pointer to the random number generator.
+ * @return double Value in [0, 1).
+ */
+static double rng_unit(Rng* rng) { return rng_next(rng) / 4294967296.0; }
+
+/**
+ * @brief Get the cell of a move index.
+ * @param move Cell index (row * SIZE + col).
+ * @return Cell The cell.
+ */
+static Cell move_cell(int move) { return (Cell){move / SIZE, move % SIZE}; }
+
+Cell best_scored_move(const double scores[SIZE * SIZE]) {
+  int best = -1;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    if (scores[i] == MOVE_SCORE_NONE) continue;
+    if (best < 0 || scores[i] > scores[best]) best = i;
+  }
+  return (best < 0) ? (Cell){-1, -1} : move_cell(best);
+}
+
+Cell softmax_scored_move(const double scores[SIZE * SIZE], double temperature,
+                         Rng* rng) {
+  Cell best = best_scored_move(scores);
+  if (temperature <= 0 || best.row < 0) return best;
+
+  // Weigh relative to the best score so the exponentials cannot overflow
+  double best_score = scores[best.row * SIZE + best.col];
+  double weights[SIZE * SIZE];
+  double total = 0.0;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    weights[i] = 0.0;
+    if (scores[i] == MOVE_SCORE_NONE) continue;
+    weights[i] = exp((scores[i] - best_score) / temperature);
+    total += weights[i];
+  }
+
+  double target = rng_unit(rng) * total;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    if (weights[i] == 0.0) continue;
+    if (target < weights[i]) return move_cell(i);
+    target -= weights[i];
+  }
+  // Rounding left the target past the last weight
+  return best;
+}
+
+Cell epsilon_scored_move(const double scores[SIZE * SIZE], double epsilon,
+                         Rng* rng) {
+  Cell best = best_scored_move(scores);
+  if (best.row < 0 || rng_unit(rng) >= epsilon) return best;
+
+  int legal[SIZE * SIZE];
+  int num_legal = 0;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    if (scores[i] != MOVE_SCORE_NONE) legal[num_legal++] = i;
+  }
+  return move_cell(legal[rng_bounded(rng, (uint32_t)num_legal)]);
+}
@@ -0,0 +1,53 @@
+#ifndef MOVE_CHOICE_H
+#define MOVE_CHOICE_H
+
+#include <float.h>
+
+#include "board.h"
+#include "rng.h"
+
+// Score of the cells that are not legal moves in a scores array
+#define MOVE_SCORE_NONE (-DBL_MAX)
+
+/* Engines that score every legal move (minimax_score_moves(),
+ * nb_score_moves()) fill an array indexed by row * SIZE + col, higher is
+ * better for the player to move. The functions below choose a move from it,
+ * so one search serves both the move and how strongly it is played. */
+
+/**
+ * @brief Choose the highest scored move.
+ * @param scores Score of each cell, MOVE_SCORE_NONE for illegal moves.
+ * @return Cell The first move with the highest score in row-major order, or
+ * {-1, -1} if there is none.
+ */
+Cell best_scored_move(const double scores[SIZE * SIZE]);
+
+/**
+ * @brief Choose a move at random, weighting each by the exponential of its
+ * score divided by a temperature.
+ *
+ * Low temperatures almost always pick the best move and high ones approach a
+ * uniformly random move. Moves that score close together are mixed up long
+ * before clearly losing ones are played.
+ *
+ * @param scores Score of each cell, MOVE_SCORE_NONE for illegal moves.
+ * @param temperature Softness of the choice in score units, 0 or less for the
+ * best move.
+ * @param rng Pointer to the random number generator.
+ * @return Cell The selected move, or {-1, -1} if there is none.
+ */
+Cell softmax_scored_move(const double scores[SIZE * SIZE], double temperature,
+                         Rng* rng);
+
+/**
+ * @brief Choose a uniformly random legal move with some probability, and the
+ * best move otherwise.
+ * @param scores Score of each cell, MOVE_SCORE_NONE for illegal moves.
+ * @param epsilon Probability of a random move, from 0 to 1.
+ * @param rng Pointer to the random number generator.
+ * @return Cell The selected move, or {-1, -1} if there is none.
+ */
+Cell epsilon_scored_move(const double scores[SIZE * SIZE], double epsilon,
+                         Rng* rng);
+
+#endif  // MOVE_CHOICE_H
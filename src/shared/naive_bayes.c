@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "model_file.h"
+
 #ifdef EMBED_NB_MODEL
 #include "nb_model.h"
 extern unsigned char nb_model_bin[];
@@ -20,108 +22,172 @@ static const unsigned int nb_model_bin_len = 0;
 #endif
 
 /**
- * @brief Invert the board state by swapping X and O.
- *
- * This is necessary because the Naive Bayes model is trained on X as the
- * positive player.
- *
- * @param board Pointer to the Board structure to invert.
+ * @brief Fill in a model from the payload of a model file.
+ * @param model Pointer to the NaiveBayesModel structure to load data into.
+ * @param file Pointer to the opened ModelFile structure.
+ * @return int 0 on success, -1 if the file does not hold a Naive Bayes model.
  */
-static void invert_board(Board* board) {
-  for (int i = 0; i < SIZE; i++) {
-    for (int j = 0; j < SIZE; j++) {
-      if (board->cells[i][j] == X) {
-        board->cells[i][j] = O;
-      } else if (board->cells[i][j] == O) {
-        board->cells[i][j] = X;
-      }
+static int read_model(NaiveBayesModel* model, const ModelFile* file) {
+  if (file->header.version == MODEL_LEGACY_VERSION) {
+    // Raw probabilities saved before model files had a header
+    if (file->header.payload_size != NB_MODEL_FILE_SIZE) {
+      fprintf(stderr, "Error: Model file has no header and is not a model\n");
+      return -1;
     }
+  } else if (model_file_expect(file, MODEL_NAIVE_BAYES, MODEL_F64,
+                               NB_MODEL_FILE_SIZE) != 0) {
+    return -1;
   }
+  memcpy(model, file->payload, NB_MODEL_FILE_SIZE);
+  nb_prepare_model(model);
+  return 0;
 }
 
 int load_nb_model(NaiveBayesModel* model, const char* model_path) {
+  ModelFile file;
   // Load from embedded binary data if file path is not provided
-  if (model_path == NULL && nb_model_bin_len == sizeof(NaiveBayesModel)) {
-    memcpy(model, nb_model_bin, sizeof(NaiveBayesModel));
-    return 0;
+  if (model_path == NULL) {
+    if (model_file_view(&file, nb_model_bin, nb_model_bin_len) != 0) return -1;
+    return read_model(model, &file);
   }
 
-  FILE* file = fopen(model_path, "rb");
-  if (!file) return -1;
-
-  size_t read_count = fread(model, sizeof(NaiveBayesModel), 1, file);
-  fclose(file);
-  if (read_count != 1) return -1;
-
-  return 0;
+  if (model_file_open(&file, model_path) != 0) return -1;
+  int result = read_model(model, &file);
+  model_file_close(&file);
+  return result;
 }
 
-float naive_bayes(Board* board, const NaiveBayesModel* model) {
-  double log_scores[OUTCOMES] = {0.0};
-  // Calculate log probability for each outcome
-  for (int outcome = 0; outcome < OUTCOMES; outcome++) {
-    // Start with log prior
-    double score = log(model->prior[outcome]);
-    // Add log likelihoods for each cell in the board
-    for (int row = 0; row < SIZE; row++) {
-      for (int col = 0; col < SIZE; col++) {
-        int cell_value = board->cells[row][col];
-        score += log(model->likelihood[outcome][row][col][cell_value]);
+void nb_prepare_model(NaiveBayesModel* model) {
+  model->log_prior_ratio = log(model->prior[POSITIVE] / model->prior[NEGATIVE]);
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      for (int state = 0; state < STATE; state++) {
+        double ratio = log(model->likelihood[POSITIVE][row][col][state] /
+                           model->likelihood[NEGATIVE][row][col][state]);
+        // O reads its own marks where the model was trained on X's
+        int swapped = (state == EMPTY) ? EMPTY : X + O - state;
+        model->log_likelihood_ratio[PLAYER_X - 1][row][col][state] = ratio;
+        model->log_likelihood_ratio[PLAYER_O - 1][row][col][swapped] = ratio;
       }
     }
-    log_scores[outcome] = score;
   }
+}
 
-  // Compute the sum of exponentials
-  double max_score =
-      log_scores[0] > log_scores[1] ? log_scores[0] : log_scores[1];
-  double total_log_score = 0;
-  for (int outcome = 0; outcome < OUTCOMES; outcome++) {
-    total_log_score += exp(log_scores[outcome] - max_score);
-  }
-  // Compute log-sum-exp: log(sum(exp(x_i))) = max + log(sum(exp(x_i - max)))
-  double lse = max_score + log(total_log_score);
-  // Convert log probabilities back to regular probabilities (normalized)
-  for (int outcome = 0; outcome < OUTCOMES; outcome++) {
-    log_scores[outcome] = exp(log_scores[outcome] - lse);
+/**
+ * @brief Sum the log odds of a win for a player over the cells of a board.
+ * @param board Pointer to the Board structure.
+ * @param model Pointer to the Naive Bayes Model.
+ * @param player The player to score the board for.
+ * @return double log(P(win) / P(no win)) for the player.
+ */
+static double log_odds(const Board* board, const NaiveBayesModel* model,
+                       Player player) {
+  const double(*ratio)[SIZE][STATE] = model->log_likelihood_ratio[player - 1];
+  double score = model->log_prior_ratio;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      score += ratio[row][col][board->cells[row][col]];
+    }
   }
+  return score;
+}
+
+/**
+ * @brief Convert log odds to a probability with the logistic function.
+ * @param x Log odds of an outcome.
+ * @return double Probability of the outcome, from 0 to 1.
+ */
+static double sigmoid(double x) { return 1.0 / (1.0 + exp(-x)); }
+
+float naive_bayes(Board* board, const NaiveBayesModel* model) {
+  double score = log_odds(board, model, PLAYER_X);
 
   // Return positive probability if it's higher, else return negative
   // probability as negative value
-  double prob_negative = log_scores[NEGATIVE];
-  double prob_positive = log_scores[POSITIVE];
-  if (prob_positive >= prob_negative) {
-    return (float)prob_positive;
+  if (score >= 0) {
+    return (float)sigmoid(score);
   } else {
-    return -(float)prob_negative;
+    return -(float)sigmoid(-score);
   }
 }
 
-Cell nb_find_move(const Board* board, const NaiveBayesModel* model) {
+double nb_log_odds(const Board* board, Player player,
+                   const NaiveBayesModel* model) {
+  return log_odds(board, model, player);
+}
+
+double nb_win_probability(const Board* board, Player player,
+                          const NaiveBayesModel* model) {
+  return sigmoid(log_odds(board, model, player));
+}
+
+int nb_score_moves(const Board* board, const NaiveBayesModel* model,
+                   double scores[SIZE * SIZE]) {
+  for (int i = 0; i < SIZE * SIZE; i++) scores[i] = MOVE_SCORE_NONE;
+  if (!board || !model) return -1;
   Player ai_player = board->current_player;
-  Cell best_move = {-1, -1};
-  float best_prob = -1.0;
-
-  Cell empty_cells[SIZE * SIZE];
-  int num_moves = find_empty_cells(board, empty_cells, SIZE * SIZE);
-
-  Board board_copy;
-  copy_board(board, &board_copy);
-  // If AI is PLAYER_O, invert the board for evaluation
-  if (ai_player == PLAYER_O) invert_board(&board_copy);
-
-  // Evaluate moves
-  for (int m = 0; m < num_moves; m++) {
-    Cell cell = empty_cells[m];
-    make_move(&board_copy, &cell);
-    float score = naive_bayes(&board_copy, model);
-    undo_move(&board_copy);
-    // Update best move if this move has a better win probability
-    if (score > best_prob) {
-      best_prob = score;
-      best_move = cell;
+  CellState mark = (ai_player == PLAYER_X) ? X : O;
+  const double(*ratio)[SIZE][STATE] =
+      model->log_likelihood_ratio[ai_player - 1];
+
+  // A move only changes its own cell, so score the board once and each move
+  // by the change of that cell's ratio from empty to the AI's mark
+  double base = log_odds(board, model, ai_player);
+  int num_moves = 0;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      if (board->cells[row][col] != EMPTY) continue;
+      double delta = ratio[row][col][mark] - ratio[row][col][EMPTY];
+      scores[row * SIZE + col] = sigmoid(base + delta);
+      num_moves++;
     }
   }
+  return num_moves;
+}
 
-  return best_move;
+Cell nb_find_move(const Board* board, const NaiveBayesModel* model) {
+  double scores[SIZE * SIZE];
+  nb_score_moves(board, model, scores);
+  return best_scored_move(scores);
+}
+
+/**
+ * @brief Sum the ratios of one cell state over the cells set in a mask.
+ * @param ratio Log likelihood ratios of one player, see NaiveBayesModel.
+ * @param mask Cells holding the state.
+ * @param state The state of those cells.
+ * @return double The sum of the ratios.
+ */
+static double mask_log_odds(const double (*ratio)[SIZE][STATE], BitMask mask,
+                            CellState state) {
+  double score = 0.0;
+  for (; mask; mask &= mask - 1) {
+    int index = bb_lowest_bit(mask);
+    score += ratio[index / SIZE][index % SIZE][state];
+  }
+  return score;
+}
+
+Cell nb_find_move_bb(const BitBoard* bitboard, Player current_player,
+                     const NaiveBayesModel* model) {
+  double scores[SIZE * SIZE];
+  for (int i = 0; i < SIZE * SIZE; i++) scores[i] = MOVE_SCORE_NONE;
+  if (!bitboard || !model) return (Cell){-1, -1};
+  CellState mark = (current_player == PLAYER_X) ? X : O;
+  const double(*ratio)[SIZE][STATE] =
+      model->log_likelihood_ratio[current_player - 1];
+
+  // Score straight from the masks, like nb_score_moves() on a Board
+  BitMask empty = bb_empty_mask(bitboard);
+  double base = model->log_prior_ratio +
+                mask_log_odds(ratio, bitboard->x, X) +
+                mask_log_odds(ratio, bitboard->o, O) +
+                mask_log_odds(ratio, empty, EMPTY);
+  for (; empty; empty &= empty - 1) {
+    int index = bb_lowest_bit(empty);
+    const double* cell = ratio[index / SIZE][index % SIZE];
+    double delta = cell[mark] - cell[EMPTY];
+    scores[index] = sigmoid(base + delta);
+  }
+  return best_scored_move(scores);
 }
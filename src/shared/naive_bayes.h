@@ -1,7 +1,10 @@
 #ifndef NAIVE_BAYES_H
 #define NAIVE_BAYES_H
 
+#include <stddef.h>
+
 #include "board.h"
+#include "move_choice.h"
 
 #define OUTCOMES 2  // Negative (loss/draw), Positive (win)
 #define STATE 3     // BLANK, X, O
@@ -11,8 +14,19 @@ typedef enum { NEGATIVE, POSITIVE } Outcome;
 typedef struct {
   double prior[OUTCOMES];
   double likelihood[OUTCOMES][SIZE][SIZE][STATE];
+  // Log-space form of the above, derived by nb_prepare_model() and not
+  // stored in model files. A board scores log_prior_ratio plus the ratio of
+  // each cell, the log odds of a positive outcome
+  double log_prior_ratio;  // log(P(pos) / P(neg))
+  // log(P(s|pos) / P(s|neg)) from the point of view of each player, indexed
+  // by player - 1. The model is trained on X as the positive player, so O's
+  // table is X's with the X and O states swapped
+  double log_likelihood_ratio[2][SIZE][SIZE][STATE];
 } NaiveBayesModel;
 
+// Bytes of a model file, the probabilities without the derived log tables
+#define NB_MODEL_FILE_SIZE offsetof(NaiveBayesModel, log_prior_ratio)
+
 /**
  * @brief Load a Naive Bayes model from a specified binary file.
  *
@@ -24,6 +38,16 @@ typedef struct {
  */
 int load_nb_model(NaiveBayesModel* model, const char* model_path);
 
+/**
+ * @brief Derive the log-space tables of a model from its probabilities.
+ *
+ * Called by load_nb_model(), and needed after filling in the probabilities
+ * any other way, e.g. by training.
+ *
+ * @param model Pointer to the NaiveBayesModel structure.
+ */
+void nb_prepare_model(NaiveBayesModel* model);
+
 /**
  * @brief Evaluate the board state using the Naive Bayes model.
  * @param board Pointer to the Board structure.
@@ -33,6 +57,37 @@ int load_nb_model(NaiveBayesModel* model, const char* model_path);
  */
 float naive_bayes(Board* board, const NaiveBayesModel* model);
 
+/**
+ * @brief Get the log odds that a player wins from a board.
+ * @param board Pointer to the Board structure.
+ * @param player The player to score the board for.
+ * @param model Pointer to the Naive Bayes Model.
+ * @return double log(P(win) / P(no win)) for the player.
+ */
+double nb_log_odds(const Board* board, Player player,
+                   const NaiveBayesModel* model);
+
+/**
+ * @brief Estimate the probability that a player wins from a board.
+ * @param board Pointer to the Board structure.
+ * @param player The player to score the board for.
+ * @param model Pointer to the Naive Bayes Model.
+ * @return double Probability of a win for the player, from 0 to 1.
+ */
+double nb_win_probability(const Board* board, Player player,
+                          const NaiveBayesModel* model);
+
+/**
+ * @brief Score every legal move of the AI player with the Naive Bayes model.
+ * @param board Pointer to the Board structure.
+ * @param model Pointer to the Naive Bayes Model.
+ * @param scores Filled in with the win probability of the AI player after
+ * each move, MOVE_SCORE_NONE for cells that are not legal moves.
+ * @return int The number of legal moves scored, or -1 on invalid parameters.
+ */
+int nb_score_moves(const Board* board, const NaiveBayesModel* model,
+                   double scores[SIZE * SIZE]);
+
 /**
  * @brief Select a move for the AI player using the Naive Bayes model.
  * @param board Pointer to the Board structure.
@@ -41,4 +96,20 @@ float naive_bayes(Board* board, const NaiveBayesModel* model);
  */
 Cell nb_find_move(const Board* board, const NaiveBayesModel* model);
 
+/**
+ * @brief Select a move for the AI player on a bitboard using the Naive Bayes
+ * model.
+ *
+ * Scores straight from the set bits of the X, O and empty masks, without
+ * expanding the bitboard to a Board, and chooses the same move as
+ * nb_find_move().
+ *
+ * @param bitboard Pointer to the BitBoard structure.
+ * @param current_player The player to move (the AI player).
+ * @param model Pointer to the Naive Bayes Model.
+ * @return Cell The selected move.
+ */
+Cell nb_find_move_bb(const BitBoard* bitboard, Player current_player,
+                     const NaiveBayesModel* model);
+
 #endif  // NAIVE_BAYES_H
@@ -0,0 +1,198 @@
+/**
+ * @file nb_batch.c
+ * @brief Batched Naive Bayes inference over arrays of packed boards.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+#include "nb_batch.h"
+
+#include <stdint.h>
+
+#include "batch_simd.h"
+
+/* The model as terms added to a board's score. An empty board scores bias,
+ * and each mark adds the change of its cell's ratio from empty */
+typedef struct {
+  float bias;
+  float x_delta[SIZE * SIZE];
+  float o_delta[SIZE * SIZE];
+} BatchTables;
+
+typedef size_t (*BatchKernel)(const PackedBoard* boards, size_t n,
+                              const BatchTables* tables, float* out);
+
+/**
+ * @brief Derive the terms of the batch kernels from a model.
+ * @param model Pointer to the Naive Bayes Model.
+ * @param tables Pointer to the BatchTables structure to fill.
+ */
+static void batch_tables(const NaiveBayesModel* model, BatchTables* tables) {
+  // Scores are for X, the positive player the model was trained on
+  const double(*ratio)[SIZE][STATE] =
+      model->log_likelihood_ratio[PLAYER_X - 1];
+  double bias = model->log_prior_ratio;
+  for (int i = 0; i < SIZE * SIZE; i++) {
+    const double* cell = ratio[i / SIZE][i % SIZE];
+    bias += cell[EMPTY];
+    tables->x_delta[i] = (float)(cell[X] - cell[EMPTY]);
+    tables->o_delta[i] = (float)(cell[O] - cell[EMPTY]);
+  }
+  tables->bias = (float)bias;
+}
+
+/**
+ * @brief Scalar kernel, also used for the boards left over by the vector
+ * kernels.
+ * @param boards Array of boards to score.
+ * @param n Number of boards in the array.
+ * @param tables Pointer to the BatchTables structure.
+ * @param out Output array of log odds.
+ * @return size_t Number of boards scored, always n.
+ */
+static size_t batch_scalar(const PackedBoard* boards, size_t n,
+                           const BatchTables* tables, float* out) {
+  for (size_t i = 0; i < n; i++) {
+    float score = tables->bias;
+    // Same order as the vector kernels: X then O for each cell
+    for (int j = 0; j < SIZE * SIZE; j++) {
+      score += (boards[i].x & BB_BIT(j)) ? tables->x_delta[j] : 0.0f;
+      score += (boards[i].o & BB_BIT(j)) ? tables->o_delta[j] : 0.0f;
+    }
+    out[i] = score;
+  }
+  return n;
+}
+
+#ifdef BATCH_SIMD
+#ifdef __SSE2__
+/**
+ * @brief SSE2 kernel, scores four boards per iteration.
+ * @param boards Array of boards to score.
+ * @param n Number of boards in the array.
+ * @param tables Pointer to the BatchTables structure.
+ * @param out Output array of log odds.
+ * @return size_t Number of boards scored, a multiple of four.
+ */
+static size_t batch_sse2(const PackedBoard* boards, size_t n,
+                         const BatchTables* tables, float* out) {
+  __m128i x_bits[SIZE * SIZE];
+  __m128i o_bits[SIZE * SIZE];
+  __m128 x_delta[SIZE * SIZE];
+  __m128 o_delta[SIZE * SIZE];
+  for (int j = 0; j < SIZE * SIZE; j++) {
+    x_bits[j] = _mm_set1_epi32((int)(1u << j));
+    o_bits[j] = _mm_set1_epi32((int)(1u << (16 + j)));
+    x_delta[j] = _mm_set1_ps(tables->x_delta[j]);
+    o_delta[j] = _mm_set1_ps(tables->o_delta[j]);
+  }
+  const __m128 bias = _mm_set1_ps(tables->bias);
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i packed = _mm_loadu_si128((const __m128i*)&boards[i]);
+    __m128 score = bias;
+    // Lanes with the cell's bit set become all ones and keep the term
+    for (int j = 0; j < SIZE * SIZE; j++) {
+      __m128i has_x =
+          _mm_cmpeq_epi32(_mm_and_si128(packed, x_bits[j]), x_bits[j]);
+      score =
+          _mm_add_ps(score, _mm_and_ps(_mm_castsi128_ps(has_x), x_delta[j]));
+      __m128i has_o =
+          _mm_cmpeq_epi32(_mm_and_si128(packed, o_bits[j]), o_bits[j]);
+      score =
+          _mm_add_ps(score, _mm_and_ps(_mm_castsi128_ps(has_o), o_delta[j]));
+    }
+    _mm_storeu_ps(&out[i], score);
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief AVX2 kernel, scores eight boards per iteration.
+ *
+ * Compiled for AVX2 regardless of the build flags and only called after the
+ * CPU has been checked for support.
+ *
+ * @param boards Array of boards to score.
+ * @param n Number of boards in the array.
+ * @param tables Pointer to the BatchTables structure.
+ * @param out Output array of log odds.
+ * @return size_t Number of boards scored, a multiple of eight.
+ */
+__attribute__((target("avx2"))) static size_t batch_avx2(
+    const PackedBoard* boards, size_t n, const BatchTables* tables,
+    float* out) {
+  __m256i x_bits[SIZE * SIZE];
+  __m256i o_bits[SIZE * SIZE];
+  __m256 x_delta[SIZE * SIZE];
+  __m256 o_delta[SIZE * SIZE];
+  for (int j = 0; j < SIZE * SIZE; j++) {
+    x_bits[j] = _mm256_set1_epi32((int)(1u << j));
+    o_bits[j] = _mm256_set1_epi32((int)(1u << (16 + j)));
+    x_delta[j] = _mm256_set1_ps(tables->x_delta[j]);
+    o_delta[j] = _mm256_set1_ps(tables->o_delta[j]);
+  }
+  const __m256 bias = _mm256_set1_ps(tables->bias);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i packed = _mm256_loadu_si256((const __m256i*)&boards[i]);
+    __m256 score = bias;
+    for (int j = 0; j < SIZE * SIZE; j++) {
+      __m256i has_x = _mm256_cmpeq_epi32(_mm256_and_si256(packed, x_bits[j]),
+                                         x_bits[j]);
+      score = _mm256_add_ps(
+          score, _mm256_and_ps(_mm256_castsi256_ps(has_x), x_delta[j]));
+      __m256i has_o = _mm256_cmpeq_epi32(_mm256_and_si256(packed, o_bits[j]),
+                                         o_bits[j]);
+      score = _mm256_add_ps(
+          score, _mm256_and_ps(_mm256_castsi256_ps(has_o), o_delta[j]));
+    }
+    _mm256_storeu_ps(&out[i], score);
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief Get the kernel of the widest instruction set the CPU supports.
+ * @return BatchKernel The kernel.
+ */
+static BatchKernel select_kernel(void) {
+  switch (batch_isa()) {
+#ifdef BATCH_SIMD
+    case BATCH_ISA_AVX2:
+      return batch_avx2;
+#ifdef __SSE2__
+    case BATCH_ISA_SSE2:
+      return batch_sse2;
+#endif
+#endif
+    default:
+      return batch_scalar;
+  }
+}
+
+void naive_bayes_batch(const PackedBoard* boards, size_t n,
+                       const NaiveBayesModel* model, float* out) {
+  if (!boards || !model || !out) return;
+
+  BatchTables tables;
+  batch_tables(model, &tables);
+  size_t done = select_kernel()(boards, n, &tables, out);
+  batch_scalar(boards + done, n - done, &tables, out + done);
+}
+
+void naive_bayes_batch_scalar(const PackedBoard* boards, size_t n,
+                              const NaiveBayesModel* model, float* out) {
+  if (!boards || !model || !out) return;
+
+  BatchTables tables;
+  batch_tables(model, &tables);
+  batch_scalar(boards, n, &tables, out);
+}
+
+const char* naive_bayes_batch_kernel(void) {
+  return batch_isa_name(batch_isa());
+}
@@ -0,0 +1,45 @@
+#ifndef NB_BATCH_H
+#define NB_BATCH_H
+
+#include <stddef.h>
+
+#include "board_batch.h"
+#include "naive_bayes.h"
+
+/**
+ * @brief Score many boards at once with the Naive Bayes model.
+ *
+ * Each board scores the log odds of a positive outcome, so the model predicts
+ * positive where the score is at least 0 and the probability is
+ * 1 / (1 + exp(-score)). Uses AVX2 or SSE2 to score several boards per
+ * instruction when the CPU supports it and the board fits in 16 bits per
+ * player, and falls back to a scalar loop otherwise. Every kernel adds the
+ * same single precision terms in the same order, so they give identical
+ * scores, which match nb_log_odds() to float precision.
+ *
+ * @param boards Array of boards to score.
+ * @param n Number of boards in the array.
+ * @param model Pointer to the Naive Bayes Model.
+ * @param out Output array of n log odds.
+ */
+void naive_bayes_batch(const PackedBoard* boards, size_t n,
+                       const NaiveBayesModel* model, float* out);
+
+/**
+ * @brief Score many boards with the scalar kernel of naive_bayes_batch, the
+ * reference the vector kernels must match exactly.
+ * @param boards Array of boards to score.
+ * @param n Number of boards in the array.
+ * @param model Pointer to the Naive Bayes Model.
+ * @param out Output array of n log odds.
+ */
+void naive_bayes_batch_scalar(const PackedBoard* boards, size_t n,
+                              const NaiveBayesModel* model, float* out);
+
+/**
+ * @brief Get the name of the kernel naive_bayes_batch runs on this CPU.
+ * @return const char* "AVX2", "SSE2" or "Scalar".
+ */
+const char* naive_bayes_batch_kernel(void);
+
+#endif  // NB_BATCH_H
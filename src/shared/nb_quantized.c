@@ -0,0 +1,82 @@
+/**
+ * @file nb_quantized.c
+ * @brief Naive Bayes model in 16-bit fixed point with integer-only inference.
+ * @authors commit2main
+ * @date 2026-10-16
+ */
+#include "nb_quantized.h"
+
+#include <string.h>
+
+#include "model_file.h"
+
+/**
+ * @brief Round a value to fixed point, saturating at the int16 range.
+ * @param value The value to convert.
+ * @return int16_t The value times NB_QUANT_ONE, rounded half away from zero.
+ */
+static int16_t to_fixed(double value) {
+  double scaled = value * NB_QUANT_ONE;
+  if (scaled >= INT16_MAX) return INT16_MAX;
+  if (scaled <= INT16_MIN) return INT16_MIN;
+  return (int16_t)(scaled + ((scaled < 0) ? -0.5 : 0.5));
+}
+
+void nb_quantize_model(const NaiveBayesModel* model,
+                       NaiveBayesQuantized* quantized) {
+  quantized->log_prior_ratio = to_fixed(model->log_prior_ratio);
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      for (int state = 0; state < STATE; state++) {
+        quantized->log_likelihood_ratio[row][col][state] = to_fixed(
+            model->log_likelihood_ratio[PLAYER_X - 1][row][col][state]);
+      }
+    }
+  }
+}
+
+int load_nb_quantized(NaiveBayesQuantized* quantized, const char* model_path) {
+  ModelFile file;
+  if (model_file_open(&file, model_path) != 0) return -1;
+  int result = model_file_expect(&file, MODEL_NAIVE_BAYES_QUANTIZED, MODEL_I16,
+                                 sizeof(NaiveBayesQuantized));
+  if (result == 0) {
+    memcpy(quantized, file.payload, sizeof(NaiveBayesQuantized));
+  }
+  model_file_close(&file);
+  return result;
+}
+
+int32_t nb_quantized_log_odds(const Board* board, Player player,
+                              const NaiveBayesQuantized* quantized) {
+  int32_t score = quantized->log_prior_ratio;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      int state = board->cells[row][col];
+      // O reads its own marks where the model was trained on X's
+      if (player == PLAYER_O && state != EMPTY) state = X + O - state;
+      score += quantized->log_likelihood_ratio[row][col][state];
+    }
+  }
+  return score;
+}
+
+Cell nb_quantized_find_move(const Board* board,
+                            const NaiveBayesQuantized* quantized) {
+  // Every move adds to the same board score, so only the moved cell decides.
+  // The AI's own mark is X in its point of view, whichever player it is
+  Cell best = {-1, -1};
+  int32_t best_delta = INT32_MIN;
+  for (int row = 0; row < SIZE; row++) {
+    for (int col = 0; col < SIZE; col++) {
+      if (board->cells[row][col] != EMPTY) continue;
+      const int16_t* cell = quantized->log_likelihood_ratio[row][col];
+      int32_t delta = (int32_t)cell[X] - cell[EMPTY];
+      if (delta > best_delta) {
+        best_delta = delta;
+        best = (Cell){row, col};
+      }
+    }
+  }
+  return best;
+}
@@ -0,0 +1,65 @@
+#ifndef NB_QUANTIZED_H
+#define NB_QUANTIZED_H
+
+#include <stdint.h>
+
+#include "board.h"
+#include "naive_bayes.h"
+
+#define NB_QUANT_SHIFT 10                   // Fraction bits of the log odds
+#define NB_QUANT_ONE (1 << NB_QUANT_SHIFT)  // Log odds of 1.0 in fixed point
+
+/* A Naive Bayes model with its log-space tables rounded to 16-bit fixed point
+ * with NB_QUANT_SHIFT fraction bits, so boards are scored with integer adds
+ * only. Entries outside the int16 range are saturated. */
+typedef struct {
+  int16_t log_prior_ratio;
+  int16_t log_likelihood_ratio[SIZE][SIZE][STATE];  // Point of view of X
+} NaiveBayesQuantized;
+
+/**
+ * @brief Round the log-space tables of a model to fixed point.
+ * @param model Pointer to the Naive Bayes Model, prepared by
+ * nb_prepare_model().
+ * @param quantized Pointer to the NaiveBayesQuantized structure to fill.
+ */
+void nb_quantize_model(const NaiveBayesModel* model,
+                       NaiveBayesQuantized* quantized);
+
+/**
+ * @brief Load a quantized Naive Bayes model from a model file.
+ * @param quantized Pointer to the NaiveBayesQuantized structure to load into.
+ * @param model_path Path to the model file.
+ * @return int 0 on success, -1 on failure.
+ */
+int load_nb_quantized(NaiveBayesQuantized* quantized, const char* model_path);
+
+/**
+ * @brief Score a board for a player with the quantized model.
+ *
+ * The player is predicted to win where the score is at least 0, the same
+ * decision naive_bayes() makes up to the rounding of the tables.
+ *
+ * @param board Pointer to the Board structure.
+ * @param player The player to score the board for.
+ * @param quantized Pointer to the quantized Naive Bayes Model.
+ * @return int32_t Log odds of a win for the player, times NB_QUANT_ONE.
+ */
+int32_t nb_quantized_log_odds(const Board* board, Player player,
+                              const NaiveBayesQuantized* quantized);
+
+/**
+ * @brief Select a move for the AI player using the quantized model.
+ *
+ * Chooses like nb_find_move(), by the change of the moved cell's log odds
+ * from empty to the AI's mark, in integers only.
+ *
+ * @param board Pointer to the Board structure.
+ * @param quantized Pointer to the quantized Naive Bayes Model.
+ * @return Cell The first move with the highest score in row-major order, or
+ * {-1, -1} if there is none.
+ */
+Cell nb_quantized_find_move(const Board* board,
+                            const NaiveBayesQuantized* quantized);
+
+#endif  // NB_QUANTIZED_H
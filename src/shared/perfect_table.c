@@ -0,0 +1,81 @@
+/**
+ * @file perfect_table.c
+ * @brief Perfect play lookup table for 3x3 Tic-Tac-Toe, generated at build
+ * time by src/tools/perfect_table_gen.c.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "perfect_table.h"
+
+#include "minimax.h"
+
+#ifdef EMBED_PERFECT_TABLE
+#include "perfect_table_data.h"
+extern unsigned char perfect_table_bin[];
+extern unsigned int perfect_table_bin_len;
+#else
+static const unsigned char* perfect_table_bin = NULL;
+static const unsigned int perfect_table_bin_len = 0;
+#endif
+
+int position_index(const Board* board) {
+  CellState own = (board->current_player == PLAYER_X) ? X : O;
+  int index = 0;
+  for (int i = SIZE * SIZE - 1; i >= 0; i--) {
+    CellState state = board->cells[i / SIZE][i % SIZE];
+    int digit = (state == EMPTY) ? 0 : (state == own) ? 1 : 2;
+    index = index * 3 + digit;
+  }
+  return index;
+}
+
+bool table_available(void) {
+  return SIZE * SIZE == TABLE_CELLS && perfect_table_bin_len == TABLE_ENTRIES;
+}
+
+/**
+ * @brief Get the table entry for a board.
+ * @param board Pointer to the Board structure.
+ * @return unsigned char The entry, or TABLE_UNREACHABLE if unavailable.
+ */
+static unsigned char table_entry(const Board* board) {
+  if (!table_available()) return TABLE_UNREACHABLE;
+  return perfect_table_bin[position_index(board)];
+}
+
+bool table_outcome(const Board* board, TableOutcome* outcome) {
+  unsigned char entry = table_entry(board);
+  if (entry == TABLE_UNREACHABLE || TABLE_MOVE(entry) == TABLE_NO_MOVE) {
+    return false;
+  }
+  *outcome = (TableOutcome)TABLE_OUTCOME(entry);
+  return true;
+}
+
+Cell table_find_move(const Board* board) {
+  unsigned char entry = table_entry(board);
+  if (entry == TABLE_UNREACHABLE || TABLE_MOVE(entry) == TABLE_NO_MOVE) {
+    return minimax_find_move(board, false, NULL);
+  }
+  int index = TABLE_MOVE(entry);
+  return (Cell){index / SIZE, index % SIZE};
+}
+
+bool table_move_is_optimal(const Board* board, const Cell* move) {
+  TableOutcome best;
+  if (!table_outcome(board, &best)) return true;
+
+  Board child;
+  copy_board(board, &child);
+  if (!make_move(&child, move)) return false;
+
+  // A finished game is only optimal if it is as good as the best outcome
+  Winner winner = check_winner(&child, NULL);
+  if (winner == DRAW) return best == TABLE_DRAW;
+  if (winner != ONGOING) return best == TABLE_WIN;
+
+  // Otherwise the opponent's outcome is the mirror of ours
+  TableOutcome reply;
+  if (!table_outcome(&child, &reply)) return true;
+  return (TableOutcome)(TABLE_WIN - reply) == best;
+}
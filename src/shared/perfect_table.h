@@ -0,0 +1,69 @@
+#ifndef PERFECT_TABLE_H
+#define PERFECT_TABLE_H
+
+#include <stdbool.h>
+
+#include "board.h"
+
+#define TABLE_CELLS 9         // The table is only generated for 3x3 boards
+#define TABLE_ENTRIES 19683   // 3^9 cell combinations
+#define TABLE_NO_MOVE 0x0F    // Best move of terminal or unreachable positions
+#define TABLE_UNREACHABLE 0xFF
+
+/*
+ * Each entry is one byte indexed by position_index(). The low 4 bits hold the
+ * best cell index (row * SIZE + col) and the high 4 bits the outcome for the
+ * player to move under perfect play.
+ */
+#define TABLE_MOVE(entry) ((entry) & 0x0F)
+#define TABLE_OUTCOME(entry) ((entry) >> 4)
+#define TABLE_ENTRY(outcome, move) ((unsigned char)(((outcome) << 4) | (move)))
+
+typedef enum { TABLE_LOSS, TABLE_DRAW, TABLE_WIN } TableOutcome;
+
+/**
+ * @brief Compute the table index of a board.
+ *
+ * Cells are read as base-3 digits in row-major order, with 1 for the marks of
+ * the player to move and 2 for the opponent's, so X and O share entries.
+ *
+ * @param board Pointer to the Board structure.
+ * @return int Index into the table, 0 to TABLE_ENTRIES - 1.
+ */
+int position_index(const Board* board);
+
+/**
+ * @brief Check whether the perfect play table was embedded at build time.
+ * @return true if table lookups are available.
+ */
+bool table_available(void);
+
+/**
+ * @brief Look up the perfect play outcome for the player to move.
+ * @param board Pointer to the Board structure.
+ * @param outcome Pointer to store the outcome.
+ * @return true on success, false if the table is unavailable or the position
+ * is terminal or unreachable.
+ */
+bool table_outcome(const Board* board, TableOutcome* outcome);
+
+/**
+ * @brief Select a move with a single table lookup.
+ *
+ * Falls back to minimax_find_move when the table is not embedded (e.g. on
+ * boards other than 3x3) or has no move for the position.
+ *
+ * @param board Pointer to the Board structure.
+ * @return Cell The selected move.
+ */
+Cell table_find_move(const Board* board);
+
+/**
+ * @brief Check whether a move keeps the best outcome available to the player.
+ * @param board Pointer to the Board structure before the move.
+ * @param move Pointer to the Cell structure of the move.
+ * @return true if the move is optimal or the table cannot judge it.
+ */
+bool table_move_is_optimal(const Board* board, const Cell* move);
+
+#endif  // PERFECT_TABLE_H
@@ -0,0 +1,42 @@
+/**
+ * @file rng.c
+ * @brief Seedable PCG32 random number generator with unbiased bounded
+ * sampling.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "rng.h"
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+void rng_seed(Rng* rng, uint64_t seed, uint64_t stream) {
+  rng->state = 0;
+  rng->increment = (stream << 1) | 1;
+  rng_next(rng);
+  rng->state += seed;
+  rng_next(rng);
+}
+
+uint32_t rng_next(Rng* rng) {
+  uint64_t old_state = rng->state;
+  rng->state = old_state * PCG_MULTIPLIER + rng->increment;
+  // XSH RR output permutation
+  uint32_t xorshifted = (uint32_t)(((old_state >> 18) ^ old_state) >> 27);
+  uint32_t rotation = (uint32_t)(old_state >> 59);
+  return (xorshifted >> rotation) | (xorshifted << ((-rotation) & 31));
+}
+
+uint32_t rng_bounded(Rng* rng, uint32_t bound) {
+  // Lemire's multiply-shift, rejecting the few low products that would bias
+  // the result towards smaller values
+  uint64_t product = (uint64_t)rng_next(rng) * bound;
+  uint32_t low = (uint32_t)product;
+  if (low < bound) {
+    uint32_t threshold = (uint32_t)(-bound) % bound;
+    while (low < threshold) {
+      product = (uint64_t)rng_next(rng) * bound;
+      low = (uint32_t)product;
+    }
+  }
+  return (uint32_t)(product >> 32);
+}
@@ -0,0 +1,40 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/* PCG32 generator state. Each instance is independent, so every thread or
+ * worker can own one instead of sharing the global rand() state. */
+typedef struct {
+  uint64_t state;
+  uint64_t increment;  // Selects the stream, always odd
+} Rng;
+
+/**
+ * @brief Seed a generator on a specific stream.
+ *
+ * The same seed and stream always reproduce the same sequence, and different
+ * streams with the same seed give independent sequences.
+ *
+ * @param rng Pointer to the Rng structure to seed.
+ * @param seed Starting seed.
+ * @param stream Stream id, e.g. a thread or worker index.
+ */
+void rng_seed(Rng* rng, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Generate the next 32-bit random value.
+ * @param rng Pointer to the Rng structure.
+ * @return uint32_t Uniformly distributed value.
+ */
+uint32_t rng_next(Rng* rng);
+
+/**
+ * @brief Generate a random value in [0, bound) without modulo bias.
+ * @param rng Pointer to the Rng structure.
+ * @param bound Exclusive upper bound, must be greater than 0.
+ * @return uint32_t Uniformly distributed value below bound.
+ */
+uint32_t rng_bounded(Rng* rng, uint32_t bound);
+
+#endif  // RNG_H
@@ -0,0 +1,30 @@
+/**
+ * @file timer.c
+ * @brief Monotonic wall clock used for search deadlines.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+// clock_gettime is hidden by -std=c99 unless POSIX is requested
+#define _POSIX_C_SOURCE 199309L
+
+#include "timer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+double timer_now_ms(void) {
+  static LARGE_INTEGER frequency;
+  if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+}
+#else
+#include <time.h>
+
+double timer_now_ms(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1e6;
+}
+#endif
@@ -0,0 +1,14 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+/**
+ * @brief Read a monotonic wall clock.
+ *
+ * Unlike clock(), this measures elapsed real time rather than CPU time, so it
+ * also advances while the process is waiting or other threads are running.
+ *
+ * @return double Milliseconds since an arbitrary fixed point.
+ */
+double timer_now_ms(void);
+
+#endif  // TIMER_H
@@ -0,0 +1,90 @@
+/**
+ * @file transposition.c
+ * @brief Fixed-size transposition table of searched positions keyed by their
+ * Zobrist key.
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include "transposition.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Packed layout of TTEntry.data, from the lowest bit */
+#define TT_SCORE_BITS 16
+#define TT_DRAFT_SHIFT 16
+#define TT_BOUND_SHIFT 24
+#define TT_MOVE_SHIFT 32
+#define TT_VALID_BIT ((uint64_t)1 << 40)  // Tells used slots from empty ones
+
+/**
+ * @brief Pack entry data into one word.
+ * @param data Pointer to the TTData structure.
+ * @return uint64_t The packed data.
+ */
+static uint64_t pack_data(const TTData* data) {
+  return (uint64_t)(uint16_t)(int16_t)data->score |
+         (uint64_t)(uint8_t)data->draft << TT_DRAFT_SHIFT |
+         (uint64_t)(uint8_t)data->bound << TT_BOUND_SHIFT |
+         (uint64_t)(uint8_t)data->move << TT_MOVE_SHIFT | TT_VALID_BIT;
+}
+
+/**
+ * @brief Unpack entry data from one word.
+ * @param packed The packed data.
+ * @param data Pointer to the TTData structure to fill.
+ */
+static void unpack_data(uint64_t packed, TTData* data) {
+  data->score = (int16_t)(uint16_t)(packed & ((1u << TT_SCORE_BITS) - 1));
+  data->draft = (uint8_t)(packed >> TT_DRAFT_SHIFT);
+  data->bound = (TTBound)(uint8_t)(packed >> TT_BOUND_SHIFT);
+  data->move = (uint8_t)(packed >> TT_MOVE_SHIFT);
+}
+
+int tt_init(TranspositionTable* tt, size_t size_kb) {
+  if (!tt || size_kb == 0) return -1;
+
+  // Largest power of two number of entries within the budget
+  size_t max_entries = size_kb * 1024 / sizeof(TTEntry);
+  if (max_entries == 0) return -1;
+  size_t num_entries = 1;
+  while (num_entries * 2 <= max_entries) num_entries *= 2;
+
+  tt->entries = calloc(num_entries, sizeof(TTEntry));
+  if (!tt->entries) {
+    fprintf(stderr, "Error: Failed to allocate transposition table\n");
+    return -1;
+  }
+  tt->mask = num_entries - 1;
+  return 0;
+}
+
+void tt_free(TranspositionTable* tt) {
+  if (!tt) return;
+  free(tt->entries);
+  tt->entries = NULL;
+  tt->mask = 0;
+}
+
+void tt_clear(TranspositionTable* tt) {
+  if (!tt || !tt->entries) return;
+  memset(tt->entries, 0, (tt->mask + 1) * sizeof(TTEntry));
+}
+
+bool tt_probe(const TranspositionTable* tt, uint64_t key, TTData* data) {
+  const TTEntry* entry = &tt->entries[key & tt->mask];
+  uint64_t key_xor_data =
+      __atomic_load_n(&entry->key_xor_data, __ATOMIC_RELAXED);
+  uint64_t packed = __atomic_load_n(&entry->data, __ATOMIC_RELAXED);
+  if (!(packed & TT_VALID_BIT) || (key_xor_data ^ packed) != key) return false;
+  unpack_data(packed, data);
+  return true;
+}
+
+void tt_store(TranspositionTable* tt, uint64_t key, const TTData* data) {
+  TTEntry* entry = &tt->entries[key & tt->mask];
+  uint64_t packed = pack_data(data);
+  __atomic_store_n(&entry->key_xor_data, key ^ packed, __ATOMIC_RELAXED);
+  __atomic_store_n(&entry->data, packed, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,80 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Default table size in KiB, overridable at build time (see meson_options.txt)
+#ifndef TT_DEFAULT_KB
+#define TT_DEFAULT_KB 1024
+#endif
+
+#define TT_NO_MOVE 0xFF  // Move index of entries without a best move
+
+typedef enum {
+  TT_EXACT,  // Score is the exact value of the position
+  TT_LOWER,  // Search failed high, the value is at least the score
+  TT_UPPER,  // Search failed low, the value is at most the score
+} TTBound;
+
+typedef struct {
+  int score;      // From the point of view of the player to move
+  int draft;      // Plies searched below the position
+  TTBound bound;  // How the score relates to the true value
+  int move;       // Cell index of the best move, or TT_NO_MOVE
+} TTData;
+
+/* Entries are read and written without locks by parallel searches. The key is
+ * stored XORed with the data, so an entry torn by two threads writing at once
+ * no longer matches its key and is ignored. */
+typedef struct {
+  uint64_t key_xor_data;
+  uint64_t data;  // TTData packed into one word
+} TTEntry;
+
+typedef struct {
+  TTEntry* entries;
+  size_t mask;  // Number of entries - 1, the count is a power of two
+} TranspositionTable;
+
+/**
+ * @brief Allocate an empty transposition table.
+ * @param tt Pointer to the TranspositionTable structure to initialise.
+ * @param size_kb Memory budget in KiB, rounded down to a power of two number
+ * of entries.
+ * @return 0 on success, -1 on invalid parameters or allocation failure.
+ */
+int tt_init(TranspositionTable* tt, size_t size_kb);
+
+/**
+ * @brief Free the memory of a transposition table.
+ * @param tt Pointer to the TranspositionTable structure.
+ */
+void tt_free(TranspositionTable* tt);
+
+/**
+ * @brief Remove every entry from a transposition table.
+ * @param tt Pointer to the TranspositionTable structure.
+ */
+void tt_clear(TranspositionTable* tt);
+
+/**
+ * @brief Look up a position in a transposition table.
+ * @param tt Pointer to the TranspositionTable structure.
+ * @param key Zobrist key of the position.
+ * @param data Pointer to store the entry data if found.
+ * @return true if the position was found, false otherwise.
+ */
+bool tt_probe(const TranspositionTable* tt, uint64_t key, TTData* data);
+
+/**
+ * @brief Store the result of searching a position, replacing whatever was in
+ * its slot.
+ * @param tt Pointer to the TranspositionTable structure.
+ * @param key Zobrist key of the position.
+ * @param data Pointer to the entry data to store.
+ */
+void tt_store(TranspositionTable* tt, uint64_t key, const TTData* data);
+
+#endif  // TRANSPOSITION_H
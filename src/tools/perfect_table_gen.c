@@ -0,0 +1,104 @@
+/**
+ * @file perfect_table_gen.c
+ * @brief Build-time generator for the perfect play lookup table.
+ *
+ * Solves every position reachable from the empty 3x3 board and writes one
+ * entry per base-3 index (see perfect_table.h), which Meson embeds with xxd.
+ *
+ * @authors commit2main
+ * @date 2026-10-15
+ */
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../shared/board.h"
+#include "../shared/perfect_table.h"
+
+#if SIZE * SIZE != TABLE_CELLS
+#error "The perfect play table can only be generated for 3x3 boards"
+#endif
+
+static unsigned char table[TABLE_ENTRIES];
+static signed char values[TABLE_ENTRIES];
+static bool solved[TABLE_ENTRIES];
+
+/**
+ * @brief Solve a position with negamax and record its table entry.
+ *
+ * Scores are from the point of view of the player to move. Like minimax(),
+ * wins are worth more the fewer moves they take, so the stored move is the
+ * fastest win or the slowest loss.
+ *
+ * @param board Pointer to the Board structure, searched in place.
+ * @return int Score of the position for the player to move.
+ */
+static int solve(Board* board) {
+  int index = position_index(board);
+  if (solved[index]) return values[index];
+
+  int empty = SIZE * SIZE - board->move_count;
+  int value;
+  int best_cell = TABLE_NO_MOVE;
+  Winner winner = check_winner(board, NULL);
+  if (winner == WIN_X || winner == WIN_O) {
+    // The previous player completed a line
+    value = -(empty + 1);
+  } else if (winner == DRAW) {
+    value = 0;
+  } else {
+    value = INT_MIN;
+    for (int i = 0; i < SIZE * SIZE; i++) {
+      Cell cell = {i / SIZE, i % SIZE};
+      if (!make_move(board, &cell)) continue;
+      int score = -solve(board);
+      undo_move(board);
+      if (score > value) {
+        value = score;
+        best_cell = i;
+      }
+    }
+  }
+
+  TableOutcome outcome = (value > 0)   ? TABLE_WIN
+                         : (value < 0) ? TABLE_LOSS
+                                       : TABLE_DRAW;
+  table[index] = TABLE_ENTRY(outcome, best_cell);
+  values[index] = (signed char)value;
+  solved[index] = true;
+  return value;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <output path>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < TABLE_ENTRIES; i++) table[i] = TABLE_UNREACHABLE;
+
+  // Entries are relative to the player to move, so one starting player
+  // reaches every position
+  Board board;
+  init_board(&board, PLAYER_X);
+  solve(&board);
+
+  int reachable = 0;
+  for (int i = 0; i < TABLE_ENTRIES; i++) reachable += solved[i];
+
+  FILE* file = fopen(argv[1], "wb");
+  if (!file) {
+    fprintf(stderr, "Error: Failed to open output file path '%s'\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  size_t written = fwrite(table, sizeof(table), 1, file);
+  fclose(file);
+  if (written != 1) {
+    fprintf(stderr, "Error: Failed to write table to '%s'\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  printf("Solved %d reachable positions\n", reachable);
+  return EXIT_SUCCESS;
+}